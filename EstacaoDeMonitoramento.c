@@ -5,19 +5,51 @@
 #include "hardware/i2c.h"
 #include "hardware/pwm.h"
 #include "hardware/pio.h"
+#include "hardware/uart.h"
+#include "hardware/clocks.h"
+#include "hardware/watchdog.h"
 #include "ws2812.pio.h"
 #include "FreeRTOS.h"
 #include "task.h"
 #include "queue.h"
 #include "lib/ssd1306.h"
+#include "lib/dashboard.h"
+#include "lib/history.h"
+#include "lib/button.h"
+#include "lib/mailbox.h"
+#include "lib/i2c_bus.h"
+#include "lib/power.h"
+#include "lib/supervisor.h"
+#include "lib/warm_state.h"
 #include "lib/font.h"
+#include "lib/prediction.h"
+#include "lib/sensor_data.h"
+#include "lib/sensor_channel.h"
+#include "lib/sensor_filter.h"
+#include "lib/rule_engine.h"
+#include "lib/telemetry_frame.h"
+#include "lib/boot_profile.h"
+#include "lib/rt_monitor.h"
+#include "lib/rain_gauge.h"
+#include "lib/sample_pool.h"
+#include "lib/static_alloc.h"
+#include "lib/instrumentation.h"
+#include "lib/latency_hist.h"
+#include "lib/console.h"
+#if HYDRO_TRACE
+#include "lib/trace_recorder.h"
+#endif
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 // Definições de pinos
 #define I2C_PORT i2c1
 #define I2C_SDA 14
 #define I2C_SCL 15
 #define OLED_ADDR 0x3C
+#define OLED_ORIENTATION SSD1306_ORIENTATION_NORMAL  // Ajuste conforme a montagem no gabinete
+#define OLED_FLASH_PERIOD_MS 500                     // Meio período da inversão piscante em CRITICAL
 #define ADC_JOYSTICK_X 26  // Simula nível de água
 #define ADC_JOYSTICK_Y 27  // Simula volume de chuva
 
@@ -28,7 +60,20 @@
 #define BUZZER_PIN 10
 #define WS2812_PIN 7
 #define NUM_PIXELS 25      // Matriz 5x5
+#define BTN_A 5
 #define BTN_B 6
+#define RAIN_GAUGE_PIN 8   // Pluviômetro de báscula (contato para GND)
+#define WS2812_FREQ 800000 // Taxa de bits da matriz
+
+// Tons do buzzer (os divisores do PWM são recalculados a cada troca de clk_sys)
+#define BUZZER_WRAP 1000
+#define TONE_WARNING_HZ 1250
+#define TONE_ALERT_HZ 2500
+#define TONE_TREND_HZ 6250
+#define SIREN_MIN_HZ 500
+#define SIREN_MAX_HZ 2000
+#define SIREN_STEP_HZ 100
+#define SIREN_STEPS ((SIREN_MAX_HZ - SIREN_MIN_HZ) / SIREN_STEP_HZ + 1)
 
 // Definições de limites
 #define WATER_LEVEL_WARNING 50    // 50% do nível máximo
@@ -37,45 +82,261 @@
 #define RAIN_VOLUME_WARNING 60    // 60% do volume máximo
 #define RAIN_VOLUME_ALERT 80      // 80% do volume máximo
 #define RAIN_VOLUME_CRITICAL 90   // 90% do volume máximo
+#define WATER_RATE_WORSENING 2.0f  // Elevação da água (%/min) que caracteriza piora
+#define RAIN_RATE_WORSENING 3.0f   // Intensificação da chuva (%/min) que caracteriza piora
+#define SENSOR_PERIOD_MS 100       // Intervalo nominal dos canais do joystick (10 Hz, adaptativo)
+
+// Rejeição de leituras espúrias do ADC antes da classificação
+#define FILTER_WINDOW 7            // Amostras na janela do detector de Hampel
+#define FILTER_HAMPEL_K 3.0f       // Limite em desvios padrão robustos (MAD)
+#define FILTER_MIN_DEVIATION 2.0f  // Desvio (%) sempre aceito, mesmo com a janela constante
+#define FILTER_CONFIRM_DELTA 5.0f  // Leitura descartada por mais que isso (%) é confirmada logo
+
+// Definições do pluviômetro de báscula
+#define RAIN_GAUGE_ENABLED 1             // 0 desativa a captura de pulsos
+#define RAIN_GAUGE_MM_PER_TIP 0.2f       // Precipitação por basculada (mm)
+#define RAIN_GAUGE_PERIOD_MS 1000        // Intervalo de cálculo da intensidade
+#define RAIN_INTENSITY_WARNING 10.0f     // Chuva forte (mm/h)
+#define RAIN_INTENSITY_ALERT 25.0f       // Chuva muito forte (mm/h)
+#define RAIN_INTENSITY_CRITICAL 50.0f    // Chuva extrema (mm/h)
+#define RAIN_INTENSITY_WORSENING 5.0f    // Intensificação ((mm/h)/min) que caracteriza piora
+
+// Interface do display
+#define UI_POLL_MS 50             // Intervalo de leitura dos botões (maior que um quadro do OLED)
+#define UI_REFRESH_MS 1000        // Atualização das páginas que não seguem as amostras
+#define BUTTON_LONG_MS 1000       // Pressão longa do botão A (ação da página)
+#define BOOTSEL_HOLD_MS 3000      // Pressão longa do botão B que reinicia em BOOTSEL
+#define DISPLAY_IDLE_MS 60000     // Display desliga após 1 min sem uso em modo NORMAL
+
+#define DISPLAY_PERIOD_NORMAL_MS 500  // Atualização do painel em modo NORMAL
+#define DISPLAY_PERIOD_ALERT_MS 100   // Atualização do painel fora do modo NORMAL
+
+#define TELEMETRY_PERIOD_MS 1000  // Intervalo entre linhas de telemetria
+#define STATION_ID 1              // Identificação da estação nos quadros binários
+#define HISTORY_PERIOD_MS 5000    // Média por coluna dos gráficos (128 colunas ≈ 10 min)
+
+// Tamanho das pilhas das tarefas (palavras) e profundidade das filas
+#define STACK_SENSOR 256
+#define STACK_PROCESSING 384          // Console: compilação e listagem de regras
+#define STACK_DISPLAY 512
+#define STACK_LED_RGB 256
+#define STACK_MATRIX 256
+#define STACK_BUZZER 256
+#define STACK_I2C_BUS 256
+#define STACK_SUPERVISOR 256
+#define QUEUE_SENSOR_LENGTH 5
+
+// Prazos do supervisor entre dois sinais de vida de cada tarefa (0 = não monitorada)
+#define HEARTBEAT_SENSOR_MS (SENSOR_IDLE_PERIOD_MS + 2000)  // Dorme até 5 s em repouso
+#define HEARTBEAT_PROCESSING_MS 1000
+#define HEARTBEAT_DISPLAY_MS 2000
+#define HEARTBEAT_ACTUATOR_MS 1000
+#define HEARTBEAT_BUZZER_MS 8000                            // A sirene dura ~5 s
+#define HEARTBEAT_I2C_BUS_MS 2000
+
+// Escalonamento por prazo (deadline monotonic, que coincide com o rate monotonic quando
+// prazo = período): na partida, quanto menor o prazo, maior a prioridade, e prazos
+// iguais dividem o mesmo nível. O servidor do I2C parte do fundo da faixa e herda a
+// prioridade dos clientes à espera (lib/i2c_bus.c); o supervisor fica fixo acima da
+// faixa, abaixo apenas da tarefa de timers do FreeRTOS.
+#define PRIORITY_BY_DEADLINE 0
+#define PRIORITY_I2C_BUS (tskIDLE_PRIORITY + 1)      // Base; sobe com os clientes à espera
+#define PRIORITY_SUPERVISOR (configMAX_PRIORITIES - 2)
+#define ACTUATOR_PERIOD_MS 100        // LED RGB, matriz e buzzer
+#define DEADLINE_SENSOR_MS SENSOR_BURST_PERIOD_MS
+#define DEADLINE_PROCESSING_MS 20     // Da chegada da amostra às caixas das saídas
+#define DEADLINE_DISPLAY_MS 200       // Um quadro do OLED pelo barramento (~23 ms) com folga
+
+// Partida em etapas: a inicialização do display espera as saídas de alarme ficarem
+// prontas (ou este prazo) para não disputar a CPU e o barramento com o primeiro alerta
+#define BOOT_DISPLAY_DEFER_MS 1000
+#define BOOT_NOTIFY_INDEX 1           // O índice 0 é usado pelo i2c_bus na espera das transações
+#define BOOT_TTA_BUDGET_US 100000     // Orçamento do tempo até a capacidade de alerta
+
+// Estado preservado em reinício a quente ("HYD" + versão do layout)
+#define WARM_STATE_MAGIC 0x48594402u
+
+// Caminhos de atuação com latência medida desde a leitura do ADC
+typedef enum {
+    LATENCY_RGB,               // update_rgb_led
+    LATENCY_MATRIX,            // display_matrix_pattern
+    LATENCY_SOUND,             // play_alert_sound
+    LATENCY_OLED,              // ssd1306_send_data concluído
+    LATENCY_CLOCK,             // clk_sys de volta ao máximo na escalada
+    LATENCY_PATH_COUNT
+} latency_path_t;
+
+// Páginas da interface do display
+typedef enum {
+    PAGE_LIVE,                 // Painel com valores ao vivo
+    PAGE_HISTORY,              // Gráficos de histórico
+    PAGE_STATS,                // Mínimo, média e máximo do histórico
+    PAGE_DIAGNOSTICS,          // Estado interno do sistema
+    PAGE_CONFIG,               // Parâmetros e ações de configuração
+    PAGE_COUNT
+} ui_page_t;
+
+// Caixas de último valor dos consumidores (display e atuadores)
+typedef enum {
+    MAILBOX_DISPLAY,
+    MAILBOX_LED,
+    MAILBOX_MATRIX,
+    MAILBOX_BUZZER,
+    MAILBOX_COUNT
+} mailbox_id_t;
 
-// Definições de estados do sistema
+// Etapas da partida, marcadas na primeira vez em que são atingidas
 typedef enum {
-    NORMAL_MODE,
-    WARNING_MODE,
-    ALERT_MODE,
-    CRITICAL_MODE
-} SystemMode;
+    BOOT_STAGE_MAIN,           // Entrada em main, após o runtime do SDK
+    BOOT_STAGE_ALARM_HW,       // ADC, matriz e clock configurados
+    BOOT_STAGE_STDIO,          // Saída padrão e console
+    BOOT_STAGE_SCHEDULER,      // Tarefas criadas, agendador em seguida
+    BOOT_STAGE_FIRST_SAMPLE,   // Primeira amostra dos canais
+    BOOT_STAGE_LED,            // Primeira amostra aplicada em cada saída de alarme
+    BOOT_STAGE_MATRIX,
+    BOOT_STAGE_BUZZER,
+    BOOT_STAGE_DISPLAY_INIT,   // Display configurado (em segundo plano)
+    BOOT_STAGE_DISPLAY_FRAME,  // Primeiro quadro no display
+    BOOT_STAGE_COUNT
+} boot_stage_t;
 
-// Estrutura para dados do sensor
+// Capacidade de alerta: as três saídas já acionadas a partir de uma amostra
+#define BOOT_ALARM_STAGES ((1u << BOOT_STAGE_LED) | (1u << BOOT_STAGE_MATRIX) | (1u << BOOT_STAGE_BUZZER))
+#define BOOT_ALL_STAGES ((1u << BOOT_STAGE_COUNT) - 1)
+
+// Eventos acumulados nas caixas até a leitura
+#define EVENT_UPDATE_MATRIX (1u << 0)
+#define EVENT_UPDATE_SOUND (1u << 1)
+
+// Definição de uma tarefa do sistema
 typedef struct {
-    uint16_t water_level;      // Nível da água (0-100%)
-    uint16_t rain_volume;      // Volume de chuva (0-100%)
-    float water_rate;          // Taxa de elevação da água (%/min)
-    float rain_rate;           // Taxa de intensificação da chuva (%/min)
-    SystemMode mode;           // Modo atual do sistema
-    bool trend_worsening;      // Tendência de piora
-    uint32_t timestamp;        // Timestamp para cálculos de taxa
-} sensor_data_t;
-
-// Estrutura para controle de alertas
+    TaskFunction_t function;   // Função da tarefa
+    const char *name;          // Nome da tarefa
+    uint32_t stack_words;      // Tamanho da pilha (palavras)
+    UBaseType_t priority;      // Prioridade (PRIORITY_BY_DEADLINE = derivada de prazo e período)
+    uint32_t period_ms;        // Período, ou intervalo mínimo entre liberações das esporádicas
+    uint32_t deadline_ms;      // Prazo de resposta de cada ciclo (≤ período)
+    uint32_t heartbeat_ms;     // Prazo do supervisor (0 = não monitorada)
+    StackType_t *stack;        // Pilha estática (NULL no modo dinâmico)
+    StaticTask_t *tcb;         // TCB estático (NULL no modo dinâmico)
+    TaskHandle_t handle;       // Handle após a criação
+} task_def_t;
+
+// Driver de canal analógico (ADC)
 typedef struct {
-    SystemMode mode;           // Modo de alerta
-    bool update_display;       // Flag para atualização do display
-    bool update_matrix;        // Flag para atualização da matriz
-    bool update_sound;         // Flag para atualização do som
-} alert_control_t;
+    uint8_t input;             // Entrada do ADC (0 = GPIO26, 1 = GPIO27)
+} adc_channel_t;
 
-// Filas para comunicação entre tarefas
+// Filas para comunicação entre tarefas (transportam referências para o pool de amostras)
 QueueHandle_t xQueueSensorData;     // Dados dos sensores
-QueueHandle_t xQueueAlertControl;   // Controle de alertas
-QueueHandle_t xQueueDisplayData;    // Dados para o display
+
+// Caixas de último valor: o display e cada atuador recebem sempre a amostra mais recente
+#if HYDRO_STATIC_ALLOCATION
+static mailbox_t mailboxes[MAILBOX_COUNT] HYDRO_ARENA;
+#else
+static mailbox_t mailboxes[MAILBOX_COUNT];
+#endif
+static const char *const mailbox_names[MAILBOX_COUNT] = { "display", "led", "matriz", "buzzer" };
+static uint32_t sensor_queue_drops = 0;
+
+// Estado preservado entre reinícios: modos e tendências, históricos e contadores.
+// Gravado pela vProcessingTask a cada intervalo do histórico e a cada evento de alerta.
+typedef struct {
+    warm_header_t header;
+    uint32_t restarts;                     // Reinícios a quente desde a última partida a frio
+    uint32_t watchdog_resets;              // Reinícios causados pelo watchdog
+    uint32_t sensor_queue_drops;
+    char fault_task[16];                   // Tarefa que parou de sinalizar antes do reinício
+    uint8_t mode;                          // Modo consolidado na última gravação
+    sensor_channels_snapshot_t channels;
+    history_t water_history;
+    history_t rain_history;
+    rule_set_t rules;                      // Regras carregadas pelo console
+} warm_state_t;
+static warm_state_t __uninitialized_ram(warm_state);
+static bool warm_start = false;
+static char last_fault_task[16] = "-";
+
+#if HYDRO_STATIC_ALLOCATION
+// Memória estática das tarefas, filas e do buffer do display
+static StackType_t sensor_stack[STACK_SENSOR] HYDRO_ARENA;
+static StackType_t processing_stack[STACK_PROCESSING] HYDRO_ARENA;
+static StackType_t display_stack[STACK_DISPLAY] HYDRO_ARENA;
+static StackType_t led_rgb_stack[STACK_LED_RGB] HYDRO_ARENA;
+static StackType_t matrix_stack[STACK_MATRIX] HYDRO_ARENA;
+static StackType_t buzzer_stack[STACK_BUZZER] HYDRO_ARENA;
+static StackType_t i2c_bus_stack[STACK_I2C_BUS] HYDRO_ARENA;
+static StackType_t supervisor_stack[STACK_SUPERVISOR] HYDRO_ARENA;
+static StaticTask_t task_tcbs[8] HYDRO_ARENA;
+
+static uint8_t sensor_queue_storage[QUEUE_SENSOR_LENGTH * sizeof(sample_ref_t)] HYDRO_ARENA;
+static StaticQueue_t queue_structs[1] HYDRO_ARENA;
+
+static uint8_t display_buffer[SSD1306_BUFFER_SIZE(WIDTH, HEIGHT)] HYDRO_ARENA;
+
+// Orçamento da arena estática, verificado em tempo de compilação
+#define STATIC_ARENA_BUDGET (16 * 1024)
+#define STATIC_ARENA_BYTES (sizeof(sensor_stack) + sizeof(processing_stack) + sizeof(display_stack) + \
+                            sizeof(led_rgb_stack) + sizeof(matrix_stack) + sizeof(buzzer_stack) + sizeof(i2c_bus_stack) + \
+                            sizeof(supervisor_stack) + \
+                            sizeof(task_tcbs) + sizeof(sensor_queue_storage) + sizeof(queue_structs) + \
+                            sizeof(mailboxes) + sizeof(display_buffer))
+_Static_assert(STATIC_ARENA_BYTES <= STATIC_ARENA_BUDGET, "Arena estatica excede o orcamento");
+#endif
 
 // Variáveis globais
 PIO pio = pio0;
 int sm = 0;
-static sensor_data_t last_sensor_data = {0};
+static const sensor_data_t empty_sensor_data = {0};
+
+// Perfil da partida
+static boot_profile_t boot_profile;
+static volatile bool boot_display_waiting = true;  // Display ainda espera a liberação da partida
+static const char *const boot_stage_names[BOOT_STAGE_COUNT] = {
+    "main", "alarme_hw", "stdio", "agendador", "amostra", "led", "matriz", "buzzer", "display_init", "display_quadro"
+};
+
+// Histogramas de latência sensor -> atuador (cada caminho é escrito por uma única tarefa)
+static latency_hist_t actuator_latency[LATENCY_PATH_COUNT];
+static const char *const latency_path_names[LATENCY_PATH_COUNT] = { "rgb", "matriz", "som", "oled", "clock" };
 static uint32_t last_alert_time = 0;
 
+// Telemetria em texto (TLM) ou em quadros binários (TLB) para o gateway da bacia
+static bool telemetry_binary = false;
+static uint16_t telemetry_sequence = 0;
+
+// Canais de sensor registrados
+static adc_channel_t adc_water = { .input = 0 };   // ADC0 = GPIO26
+static adc_channel_t adc_rain = { .input = 1 };    // ADC1 = GPIO27
+static int ch_water = -1;
+static int ch_rain = -1;
+static hampel_filter_t water_filter;
+static hampel_filter_t rain_filter;
+
+// Regras de alerta do local (carregadas pelo console, avaliadas pela vSensorTask)
+static rule_set_t rules;
+static uint8_t rules_active = 0;
+static uint32_t rules_eval_max_us = 0;
+
+// Histórico de nível e chuva (escrito pela vProcessingTask, lido pelo display)
+static history_t water_history;
+static history_t rain_history;
+
+#if RAIN_GAUGE_ENABLED
+static rain_gauge_t rain_gauge;
+static bool rain_gauge_ready = false;
+#endif
+
+// Divisores do PWM do buzzer por tom, válidos para o clk_sys atual
+enum {
+    TONE_WARNING,
+    TONE_ALERT,
+    TONE_TREND,
+    TONE_SIREN,                // Primeiro degrau da sirene (SIREN_MIN_HZ)
+    TONE_COUNT = TONE_SIREN + SIREN_STEPS
+};
+static float tone_clkdiv[TONE_COUNT];
+
 // Protótipos de funções
 void vSensorTask(void *params);
 void vProcessingTask(void *params);
@@ -84,11 +345,51 @@ void vLedRGBTask(void *params);
 void vMatrixLedTask(void *params);
 void vBuzzerTask(void *params);
 void init_hardware(void);
+void register_sensor_channels(void);
+void report_memory_map(void);
+float read_adc_percent(void *ctx);
 void update_rgb_led(SystemMode mode, bool trend_worsening);
 void play_alert_sound(SystemMode mode, bool trend_worsening);
 void display_matrix_pattern(SystemMode mode, bool trend_worsening);
 uint32_t urgb_u32(uint8_t r, uint8_t g, uint8_t b);
 void put_pixel(uint32_t pixel_grb);
+const sensor_data_t *acquire_last_sensor_data(sample_ref_t *ref);
+void record_latency(latency_path_t path, uint32_t sampled_us);
+void cmd_latency(int argc, char **argv);
+void cmd_trace(int argc, char **argv);
+void cmd_i2c(int argc, char **argv);
+void cmd_mailbox(int argc, char **argv);
+void cmd_power(int argc, char **argv);
+void cmd_rules(int argc, char **argv);
+void cmd_telemetry(int argc, char **argv);
+void cmd_boot(int argc, char **argv);
+void boot_mark(boot_stage_t stage);
+void boot_output_ready(boot_stage_t stage);
+void apply_rules(sensor_data_t *data, uint32_t now_ms);
+void cmd_supervisor(int argc, char **argv);
+void assign_priorities(void);
+void cmd_realtime(int argc, char **argv);
+bool warm_restore(void);
+void warm_checkpoint(SystemMode mode);
+void on_task_fault(const char *task_name);
+void update_tone_table(uint32_t sys_hz);
+void on_clock_changed(uint32_t sys_hz);
+power_level_t power_level_for(const sensor_data_t *data);
+void send_telemetry(const sensor_data_t *data);
+void render_diagnostics(ssd1306_t *display, uint32_t now_ms);
+void render_config(ssd1306_t *display, ssd1306_orientation_t orientation);
+
+// Tarefas do sistema
+static task_def_t tasks[] = {
+    { vSensorTask, "Sensor Task", STACK_SENSOR, PRIORITY_BY_DEADLINE, SENSOR_BURST_PERIOD_MS, DEADLINE_SENSOR_MS, HEARTBEAT_SENSOR_MS, STATIC_MEMORY(sensor_stack), STATIC_MEMORY(&task_tcbs[0]), NULL },
+    { vProcessingTask, "Processing Task", STACK_PROCESSING, PRIORITY_BY_DEADLINE, SENSOR_BURST_PERIOD_MS, DEADLINE_PROCESSING_MS, HEARTBEAT_PROCESSING_MS, STATIC_MEMORY(processing_stack), STATIC_MEMORY(&task_tcbs[1]), NULL },
+    { vDisplayTask, "Display Task", STACK_DISPLAY, PRIORITY_BY_DEADLINE, UI_POLL_MS, DEADLINE_DISPLAY_MS, HEARTBEAT_DISPLAY_MS, STATIC_MEMORY(display_stack), STATIC_MEMORY(&task_tcbs[2]), NULL },
+    { vLedRGBTask, "LED RGB Task", STACK_LED_RGB, PRIORITY_BY_DEADLINE, ACTUATOR_PERIOD_MS, ACTUATOR_PERIOD_MS, HEARTBEAT_ACTUATOR_MS, STATIC_MEMORY(led_rgb_stack), STATIC_MEMORY(&task_tcbs[3]), NULL },
+    { vMatrixLedTask, "Matrix LED Task", STACK_MATRIX, PRIORITY_BY_DEADLINE, ACTUATOR_PERIOD_MS, ACTUATOR_PERIOD_MS, HEARTBEAT_ACTUATOR_MS, STATIC_MEMORY(matrix_stack), STATIC_MEMORY(&task_tcbs[4]), NULL },
+    { vBuzzerTask, "Buzzer Task", STACK_BUZZER, PRIORITY_BY_DEADLINE, ACTUATOR_PERIOD_MS, ACTUATOR_PERIOD_MS, HEARTBEAT_BUZZER_MS, STATIC_MEMORY(buzzer_stack), STATIC_MEMORY(&task_tcbs[5]), NULL },
+    { vI2CBusTask, "I2C Bus Task", STACK_I2C_BUS, PRIORITY_I2C_BUS, 0, 0, HEARTBEAT_I2C_BUS_MS, STATIC_MEMORY(i2c_bus_stack), STATIC_MEMORY(&task_tcbs[6]), NULL },
+    { vSupervisorTask, "Supervisor Task", STACK_SUPERVISOR, PRIORITY_SUPERVISOR, SUPERVISOR_PERIOD_MS, SUPERVISOR_PERIOD_MS, 0, STATIC_MEMORY(supervisor_stack), STATIC_MEMORY(&task_tcbs[7]), NULL },
+};
 
 // Padrões para a matriz de LEDs
 static const bool normal_pattern[NUM_PIXELS] = {
@@ -133,192 +434,335 @@ static const bool arrow_up_pattern[NUM_PIXELS] = {
 
 // Tarefa de leitura dos sensores (simulados pelo joystick)
 void vSensorTask(void *params) {
-    adc_init();
-    adc_gpio_init(ADC_JOYSTICK_X);
-    adc_gpio_init(ADC_JOYSTICK_Y);
-    
-    sensor_data_t sensor_data;
-    sensor_data.timestamp = xTaskGetTickCount();
-    sensor_data.water_rate = 0;
-    sensor_data.rain_rate = 0;
-    sensor_data.trend_worsening = false;
-    
-    uint16_t prev_water = 0;
-    uint16_t prev_rain = 0;
+    uint32_t next_ms = SENSOR_PERIOD_MS;
     
     while (true) {
-        // Leitura do nível de água (eixo X do joystick)
-        adc_select_input(0); // ADC0 = GPIO26
-        uint16_t raw_water = adc_read();
-        sensor_data.water_level = (raw_water * 100) / 4095;
+        supervisor_beat();
         
-        // Leitura do volume de chuva (eixo Y do joystick)
-        adc_select_input(1); // ADC1 = GPIO27
-        uint16_t raw_rain = adc_read();
-        sensor_data.rain_volume = (raw_rain * 100) / 4095;
-        
-        // Cálculo da taxa de variação a cada 5 segundos
-        uint32_t current_time = xTaskGetTickCount();
-        if (current_time - sensor_data.timestamp >= pdMS_TO_TICKS(5000)) {
-            float time_diff = (current_time - sensor_data.timestamp) / 1000.0f / 60.0f; // em minutos
-            
-            // Calcula taxa de elevação da água (%/min)
-            sensor_data.water_rate = (float)(sensor_data.water_level - prev_water) / time_diff;
+        // Amostra diretamente em um bloco do pool, sem cópias intermediárias
+        sample_ref_t ref = sample_pool_alloc();
+        if (ref != SAMPLE_REF_NONE) {
+            // Amostra os canais vencidos e consolida modo, taxas e previsões
+            sensor_data_t *sensor_data = sample_pool_get(ref);
+            uint32_t now_ms = xTaskGetTickCount() * portTICK_PERIOD_MS;
+            sensor_data->sampled_us = time_us_32();
+            next_ms = sensor_channels_sample(sensor_data, now_ms);
+            boot_mark(BOOT_STAGE_FIRST_SAMPLE);
             
-            // Calcula taxa de intensificação da chuva (%/min)
-            sensor_data.rain_rate = (float)(sensor_data.rain_volume - prev_rain) / time_diff;
-            
-            // Verifica tendência de piora
-            sensor_data.trend_worsening = (sensor_data.water_rate > 2.0f || sensor_data.rain_rate > 3.0f);
-            
-            // Atualiza valores anteriores e timestamp
-            prev_water = sensor_data.water_level;
-            prev_rain = sensor_data.rain_volume;
-            sensor_data.timestamp = current_time;
-        }
-        
-        // Determina o modo do sistema com base nos níveis
-        if (sensor_data.water_level >= WATER_LEVEL_CRITICAL || sensor_data.rain_volume >= RAIN_VOLUME_CRITICAL) {
-            sensor_data.mode = CRITICAL_MODE;
-        } else if (sensor_data.water_level >= WATER_LEVEL_ALERT || sensor_data.rain_volume >= RAIN_VOLUME_ALERT) {
-            sensor_data.mode = ALERT_MODE;
-        } else if (sensor_data.water_level >= WATER_LEVEL_WARNING || sensor_data.rain_volume >= RAIN_VOLUME_WARNING) {
-            sensor_data.mode = WARNING_MODE;
-        } else {
-            sensor_data.mode = NORMAL_MODE;
+            // Envia a referência para a fila (a referência passa para o consumidor)
+            if (xQueueSend(xQueueSensorData, &ref, 0) == pdTRUE) {
+                instr_queue_sent(INSTR_QUEUE_SENSOR);
+            } else {
+                sensor_queue_drops++;
+                sample_pool_release(ref);
+            }
         }
         
-        // Envia dados para a fila
-        xQueueSend(xQueueSensorData, &sensor_data, 0);
-        
-        // Atraso para próxima leitura (10 Hz)
-        vTaskDelay(pdMS_TO_TICKS(100));
+        // Aguarda até o próximo canal vencer, contado da liberação deste ciclo
+        rt_monitor_wait_ms(next_ms);
     }
 }
 
 // Tarefa de processamento de dados e controle de alertas
 void vProcessingTask(void *params) {
-    sensor_data_t sensor_data;
-    alert_control_t alert_control;
+    sample_ref_t ref;
     SystemMode last_mode = NORMAL_MODE;
-    uint32_t display_update_counter = 0;
+    bool last_pre_alert = false;
+    uint32_t last_display_time = 0;
+    uint32_t last_telemetry_time = 0;
+    bool boot_reported = false;
     
     while (true) {
-        // Recebe dados dos sensores
-        if (xQueueReceive(xQueueSensorData, &sensor_data, pdMS_TO_TICKS(100)) == pdTRUE) {
-            // Copia dados para uso global
-            last_sensor_data = sensor_data;
+        supervisor_beat();
+        
+        // Recebe dados dos sensores (tarefa esporádica: o ciclo vai da chegada da amostra às caixas)
+        if (xQueueReceive(xQueueSensorData, &ref, pdMS_TO_TICKS(100)) == pdTRUE) {
+            rt_monitor_begin();
+            sensor_data_t *sensor_data = sample_pool_get(ref);
+            alert_control_t *alert_control = &sensor_data->alert;
             
             // Configura controle de alertas
-            alert_control.mode = sensor_data.mode;
+            alert_control->mode = sensor_data->mode;
             
-            // Atualiza display a cada ciclo em modo de alerta, ou a cada 5 ciclos em modo normal
-            display_update_counter++;
-            if (sensor_data.mode != NORMAL_MODE || display_update_counter >= 5) {
-                alert_control.update_display = true;
-                display_update_counter = 0;
-            } else {
-                alert_control.update_display = false;
+            // Clock máximo antes de acionar as saídas na escalada; redução com atraso no retorno
+            power_level_t power_level = power_level_for(sensor_data);
+            if (power_request(power_level, sensor_data->timestamp) && power_level == POWER_LEVEL_FULL) {
+                record_latency(LATENCY_CLOCK, sensor_data->sampled_us);
             }
             
-            // Atualiza matriz de LEDs quando o modo muda ou a cada 10 segundos em modo de alerta
+            // Atualiza display por tempo (a taxa de amostragem é adaptativa): a cada
+            // 100 ms fora do modo normal, a cada 500 ms em modo normal e na troca de modo
             uint32_t current_time = xTaskGetTickCount();
-            if (sensor_data.mode != last_mode || 
-                (sensor_data.mode != NORMAL_MODE && current_time - last_alert_time >= pdMS_TO_TICKS(10000))) {
-                alert_control.update_matrix = true;
-                alert_control.update_sound = true;
+            uint32_t display_period = sensor_data->mode != NORMAL_MODE ? DISPLAY_PERIOD_ALERT_MS
+                                                                       : DISPLAY_PERIOD_NORMAL_MS;
+            if (sensor_data->mode != last_mode || current_time - last_display_time >= pdMS_TO_TICKS(display_period)) {
+                alert_control->update_display = true;
+                last_display_time = current_time;
+            } else {
+                alert_control->update_display = false;
+            }
+            
+            // Atualiza matriz de LEDs quando o modo muda, ao entrar em pré-alerta
+            // ou a cada 10 segundos em modo de alerta
+            if (sensor_data->mode != last_mode || (sensor_data->pre_alert && !last_pre_alert) ||
+                (sensor_data->mode != NORMAL_MODE && current_time - last_alert_time >= pdMS_TO_TICKS(10000))) {
+                alert_control->update_matrix = true;
+                alert_control->update_sound = true;
                 last_alert_time = current_time;
             } else {
-                alert_control.update_matrix = false;
-                alert_control.update_sound = false;
+                alert_control->update_matrix = false;
+                alert_control->update_sound = false;
             }
             
             // Atualiza último modo
-            last_mode = sensor_data.mode;
+            last_mode = sensor_data->mode;
+            last_pre_alert = sensor_data->pre_alert;
+            
+            // Publica a amostra para uso global (o bloco não é mais alterado a partir daqui)
+            sample_pool_publish(ref);
+            
+            // Histórico para os gráficos do display
+            bool rolled = history_add(&water_history, sensor_data->value[ch_water], sensor_data->timestamp);
+            rolled = history_add(&rain_history, sensor_data->value[ch_rain], sensor_data->timestamp) || rolled;
+            
+            // Telemetria periódica
+            if (current_time - last_telemetry_time >= pdMS_TO_TICKS(TELEMETRY_PERIOD_MS)) {
+                send_telemetry(sensor_data);
+                last_telemetry_time = current_time;
+            }
             
             // Envia dados para o display
-            if (alert_control.update_display) {
-                xQueueSend(xQueueDisplayData, &sensor_data, 0);
+            if (alert_control->update_display) {
+                sample_pool_retain(ref);
+                mailbox_post(&mailboxes[MAILBOX_DISPLAY], ref, 0);
+            }
+            
+            // Cada atuador tem sua própria caixa; os pedidos de atualização se acumulam
+            // até a leitura mesmo que a amostra seja substituída por outra mais nova
+            uint32_t events = (alert_control->update_matrix ? EVENT_UPDATE_MATRIX : 0) |
+                              (alert_control->update_sound ? EVENT_UPDATE_SOUND : 0);
+            sample_pool_retain(ref);
+            mailbox_post(&mailboxes[MAILBOX_LED], ref, 0);
+            sample_pool_retain(ref);
+            mailbox_post(&mailboxes[MAILBOX_MATRIX], ref, events);
+            sample_pool_retain(ref);
+            mailbox_post(&mailboxes[MAILBOX_BUZZER], ref, events);
+            
+            // Estado para reinício a quente, gravado depois de acionar as saídas
+            if (rolled || alert_control->update_matrix) {
+                warm_checkpoint(sensor_data->mode);
             }
             
-            // Envia controle de alertas
-            xQueueSend(xQueueAlertControl, &alert_control, 0);
+            // Libera a referência recebida do sensor
+            sample_pool_release(ref);
+            rt_monitor_end();
         }
+        
+        // Relatórios da partida adiados para depois do primeiro alerta e do display
+        if (!boot_reported && boot_profile_reached(&boot_profile, BOOT_ALL_STAGES)) {
+            cmd_boot(0, NULL);
+            report_memory_map();
+            boot_reported = true;
+        }
+        
+        // Comandos recebidos pela entrada padrão
+        console_poll();
+        
+        // Relatório periódico de instrumentação (vazio quando desativada)
+        instr_poll(xTaskGetTickCount() * portTICK_PERIOD_MS);
     }
 }
 
 // Tarefa de controle do display OLED
 void vDisplayTask(void *params) {
-    // Inicializa I2C para o display OLED
-    i2c_init(I2C_PORT, 400 * 1000);
-    gpio_set_function(I2C_SDA, GPIO_FUNC_I2C);
-    gpio_set_function(I2C_SCL, GPIO_FUNC_I2C);
-    gpio_pull_up(I2C_SDA);
-    gpio_pull_up(I2C_SCL);
-    
-    // Inicializa display OLED
+    // Inicialização em segundo plano: aguarda as saídas de alarme (ou o prazo) em um
+    // índice de notificação próprio, separado da espera das transações I2C
+    ulTaskNotifyTakeIndexed(BOOT_NOTIFY_INDEX, pdTRUE, pdMS_TO_TICKS(BOOT_DISPLAY_DEFER_MS));
+    boot_display_waiting = false;
+    supervisor_beat();
+    
+    // Inicializa display OLED (escritas passam pelo gerenciador do barramento I2C)
     ssd1306_t display;
+#if HYDRO_STATIC_ALLOCATION
+    ssd1306_init_with_buffer(&display, WIDTH, HEIGHT, false, OLED_ADDR, I2C_PORT, display_buffer);
+#else
     ssd1306_init(&display, WIDTH, HEIGHT, false, OLED_ADDR, I2C_PORT);
+#endif
+    ssd1306_set_transport(&display, i2c_bus_ssd1306_write, NULL);
     ssd1306_config(&display);
+    ssd1306_orientation_t orientation = OLED_ORIENTATION;
+    if (orientation != SSD1306_ORIENTATION_NORMAL) {
+        ssd1306_set_orientation(&display, orientation);
+    }
+    boot_mark(BOOT_STAGE_DISPLAY_INIT);
     
-    // Buffer para strings
-    char buffer[32];
-    sensor_data_t sensor_data;
+    // Gráficos rolantes alimentados pelo histórico
+    static sparkline_t water_graph, rain_graph;
+    sparkline_init(&water_graph);
+    sparkline_init(&rain_graph);
+    
+    // Botão A avança e B volta de página; pressão longa em A executa a ação da página
+    // e pressão longa em B reinicia em modo BOOTSEL
+    button_t button_a, button_b;
+    button_init(&button_a, BTN_A, BUTTON_LONG_MS);
+    button_init(&button_b, BTN_B, BOOTSEL_HOLD_MS);
+    
+    ui_page_t page = PAGE_LIVE;
+    bool awake = true;
+    bool redraw = true;
+    SystemMode last_mode = NORMAL_MODE;
+    uint32_t last_input_ms = 0;
+    uint32_t last_refresh_ms = 0;
+    sample_ref_t ref;
     
     while (true) {
-        if (xQueueReceive(xQueueDisplayData, &sensor_data, portMAX_DELAY) == pdTRUE) {
-            // Limpa o display
-            ssd1306_fill(&display, false);
-            
-            // Título do sistema
-            ///ssd1306_draw_string(&display, "MONITOR DE CHEIAS", 0, 0);
-            //ssd1306_line(&display, 0, 10, 127, 10, true);
-            
-            // Exibe nível de água
-            sprintf(buffer, "Nivel: %d%%", sensor_data.water_level);
-            ssd1306_draw_string(&display, buffer, 0, 16);
-            
-            // Barra de progresso para nível de água
-            ssd1306_rect(&display, 64, 16, 60, 8, true, false);
-            uint8_t bar_width = (sensor_data.water_level * 58) / 100;
-            if (bar_width > 0) {
-                ssd1306_rect(&display, 64, 17, bar_width, 6, true, true);
+        supervisor_beat();
+        
+        // Acorda com a amostra nova (sem esperar a liberação) ou, no máximo, na próxima
+        // liberação periódica para ler os botões
+        ref = mailbox_take(&mailboxes[MAILBOX_DISPLAY], NULL, rt_monitor_timeout());
+        rt_monitor_begin();
+        bool fresh = ref != SAMPLE_REF_NONE;
+        uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+        const sensor_data_t *sensor_data = fresh ? sample_pool_get(ref) : acquire_last_sensor_data(&ref);
+        
+        button_event_t event_a = button_poll(&button_a, now);
+        button_event_t event_b = button_poll(&button_b, now);
+        if (event_b == BUTTON_EVENT_LONG) {
+            reset_usb_boot(0, 0);
+        }
+        
+        if (event_a != BUTTON_EVENT_NONE || event_b != BUTTON_EVENT_NONE) {
+            last_input_ms = now;
+            redraw = true;
+            if (!awake) {
+                // O primeiro toque apenas acorda o display
+                ssd1306_set_power(&display, true);
+                awake = true;
+            } else if (event_a == BUTTON_EVENT_SHORT) {
+                page = (ui_page_t)((page + 1) % PAGE_COUNT);
+            } else if (event_b == BUTTON_EVENT_SHORT) {
+                page = (ui_page_t)((page + PAGE_COUNT - 1) % PAGE_COUNT);
+            } else if (event_a == BUTTON_EVENT_LONG && page == PAGE_CONFIG) {
+                orientation = orientation == SSD1306_ORIENTATION_NORMAL ? SSD1306_ORIENTATION_ROTATE_180
+                                                                        : SSD1306_ORIENTATION_NORMAL;
+                ssd1306_set_orientation(&display, orientation);
             }
-            
-            // Exibe volume de chuva
-            sprintf(buffer, "Chuva: %d%%", sensor_data.rain_volume);
-            ssd1306_draw_string(&display, buffer, 0, 32);
-            
-            // Barra de progresso para volume de chuva
-            ssd1306_rect(&display, 64, 32, 60, 8, true, false);
-            bar_width = (sensor_data.rain_volume * 58) / 100;
-            if (bar_width > 0) {
-                ssd1306_rect(&display, 64, 33, bar_width, 6, true, true);
+        }
+        
+        // Ao sair do modo NORMAL o display acorda e volta para a página ao vivo
+        if (sensor_data->mode != NORMAL_MODE && last_mode == NORMAL_MODE) {
+            if (!awake) {
+                ssd1306_set_power(&display, true);
+                awake = true;
             }
-            
-            // Exibe status do sistema
-            ssd1306_line(&display, 0, 48, 127, 48, true);
-            switch (sensor_data.mode) {
-                case NORMAL_MODE:
-                    ssd1306_draw_string(&display, "STATUS: NORMAL", 0, 50);
-                    break;
-                case WARNING_MODE:
-                    ssd1306_draw_string(&display, "STATUS: ATENCAO!", 0, 50);
-                    break;
-                case ALERT_MODE:
-                    ssd1306_draw_string(&display, "STATUS: ALERTA!", 0, 50);
-                    break;
-                case CRITICAL_MODE:
-                    ssd1306_draw_string(&display, "EVACUACAO IMEDIATA!", 0, 50);
-                    break;
+            page = PAGE_LIVE;
+            redraw = true;
+        }
+        last_mode = sensor_data->mode;
+        
+        // Repouso do display sem uso, apenas em modo NORMAL
+        if (awake && sensor_data->mode == NORMAL_MODE && now - last_input_ms >= DISPLAY_IDLE_MS) {
+            ssd1306_set_power(&display, false);
+            awake = false;
+        }
+        
+        // Só a página visível é desenhada, e só quando há algo novo para ela
+        bool due = redraw || (page == PAGE_LIVE ? fresh
+                                                : page != PAGE_CONFIG && now - last_refresh_ms >= UI_REFRESH_MS);
+        if (!awake || !due) {
+            if (ref != SAMPLE_REF_NONE) {
+                sample_pool_release(ref);
             }
-            
-            // Atualiza o display
-            ssd1306_send_data(&display);
+            rt_monitor_end();
+            continue;
+        }
+        
+        sparkline_sync(&water_graph, &water_history);
+        sparkline_sync(&rain_graph, &rain_history);
+        switch (page) {
+            case PAGE_LIVE:
+                dashboard_render(&display, sensor_data, ch_water, ch_rain);
+                dashboard_draw_history(&display, &water_graph, &rain_graph);
+                break;
+            case PAGE_HISTORY:
+                dashboard_render_history(&display, &water_graph, &rain_graph, HISTORY_PERIOD_MS);
+                break;
+            case PAGE_STATS:
+                dashboard_render_stats(&display, &water_history, &rain_history);
+                break;
+            case PAGE_DIAGNOSTICS:
+                render_diagnostics(&display, now);
+                break;
+            default:
+                render_config(&display, orientation);
+                break;
+        }
+        
+        // Em CRITICAL o controlador pisca a página ao vivo invertendo o vídeo
+        ssd1306_invert(&display, page == PAGE_LIVE && sensor_data->mode == CRITICAL_MODE &&
+                                 (sensor_data->timestamp / OLED_FLASH_PERIOD_MS) % 2 == 1);
+        
+        // Libera a amostra antes da transferência I2C
+        uint32_t sampled_us = sensor_data->sampled_us;
+        if (ref != SAMPLE_REF_NONE) {
+            sample_pool_release(ref);
+        }
+        
+        // Atualiza o display
+        ssd1306_send_data(&display);
+        boot_mark(BOOT_STAGE_DISPLAY_FRAME);
+        if (page == PAGE_LIVE && fresh) {
+            record_latency(LATENCY_OLED, sampled_us);
         }
+        last_refresh_ms = now;
+        redraw = false;
+        rt_monitor_end();
     }
 }
 
+// Página de diagnóstico: tempo ligado, prazos perdidos, pool de amostras, barramento I2C
+// e latência do OLED
+void render_diagnostics(ssd1306_t *display, uint32_t now_ms) {
+    char buffer[32];
+    i2c_bus_stats_t bus;
+    
+    i2c_bus_get_stats(&bus);
+    ssd1306_fill(display, false);
+    ssd1306_draw_string(display, "DIAGNOSTICO", 0, 0);
+    snprintf(buffer, sizeof(buffer), "Up %luh%02lum Prz%lu", (unsigned long)(now_ms / 3600000),
+             (unsigned long)(now_ms / 60000 % 60), (unsigned long)rt_monitor_total_misses());
+    ssd1306_draw_string(display, buffer, 0, 12);
+    snprintf(buffer, sizeof(buffer), "Pool %u f%lu", sample_pool_free_count(),
+             (unsigned long)sample_pool_alloc_failures());
+    ssd1306_draw_string(display, buffer, 0, 22);
+    snprintf(buffer, sizeof(buffer), "I2C e%lu Rej%lu", (unsigned long)bus.errors,
+             (unsigned long)(water_filter.rejected + rain_filter.rejected));
+    ssd1306_draw_string(display, buffer, 0, 32);
+    snprintf(buffer, sizeof(buffer), "I2C max %luus", (unsigned long)bus.max_high_wait_us);
+    ssd1306_draw_string(display, buffer, 0, 42);
+    snprintf(buffer, sizeof(buffer), "OLED p99 %lums",
+             (unsigned long)(latency_hist_percentile(&actuator_latency[LATENCY_OLED], 99.0f) / 1000));
+    ssd1306_draw_string(display, buffer, 0, 52);
+}
+
+// Página de configuração: parâmetros atuais; pressão longa em A gira a tela
+void render_config(ssd1306_t *display, ssd1306_orientation_t orientation) {
+    char buffer[32];
+    
+    ssd1306_fill(display, false);
+    ssd1306_draw_string(display, "CONFIG", 0, 0);
+    snprintf(buffer, sizeof(buffer), "Amostra %lums", (unsigned long)sensor_channel_period(ch_water));
+    ssd1306_draw_string(display, buffer, 0, 12);
+    snprintf(buffer, sizeof(buffer), "Hist %ds/col", HISTORY_PERIOD_MS / 1000);
+    ssd1306_draw_string(display, buffer, 0, 22);
+    snprintf(buffer, sizeof(buffer), "Clock %luMHz%s", (unsigned long)(power_level_khz(power_get_level()) / 1000),
+             power_is_manual() ? " M" : "");
+    ssd1306_draw_string(display, buffer, 0, 32);
+    ssd1306_draw_string(display, orientation == SSD1306_ORIENTATION_NORMAL ? "Tela normal" : "Tela 180", 0, 42);
+    ssd1306_draw_string(display, "A longo: girar", 0, 54);
+}
+
 // Tarefa de controle do LED RGB
 void vLedRGBTask(void *params) {
     // Configura pinos do LED RGB como PWM
@@ -346,23 +790,33 @@ void vLedRGBTask(void *params) {
     pwm_set_enabled(slice_green, true);
     pwm_set_enabled(slice_blue, true);
     
-    alert_control_t alert_control;
+    sample_ref_t alert_ref;
     uint32_t blink_counter = 0;
     bool blink_state = false;
     
     while (true) {
-        if (xQueueReceive(xQueueAlertControl, &alert_control, pdMS_TO_TICKS(100)) == pdTRUE) {
+        supervisor_beat();
+        alert_ref = mailbox_take(&mailboxes[MAILBOX_LED], NULL, 0);
+        if (alert_ref != SAMPLE_REF_NONE) {
+            const sensor_data_t *alert_data = sample_pool_get(alert_ref);
+            
             // Atualiza LED RGB com base no modo
-            update_rgb_led(alert_control.mode, last_sensor_data.trend_worsening);
+            update_rgb_led(alert_data->alert.mode, alert_data->trend_worsening);
+            record_latency(LATENCY_RGB, alert_data->sampled_us);
+            boot_output_ready(BOOT_STAGE_LED);
+            sample_pool_release(alert_ref);
         }
         
+        sample_ref_t last_ref;
+        const sensor_data_t *last_sensor_data = acquire_last_sensor_data(&last_ref);
+        
         // Efeito de piscada para modos de alerta
         blink_counter++;
         if (blink_counter >= 5) {  // A cada 500ms
             blink_counter = 0;
             blink_state = !blink_state;
             
-            if (last_sensor_data.mode == CRITICAL_MODE) {
+            if (last_sensor_data->mode == CRITICAL_MODE) {
                 // Pisca vermelho em modo crítico
                 if (blink_state) {
                     pwm_set_chan_level(slice_red, chan_red, 255);
@@ -373,11 +827,11 @@ void vLedRGBTask(void *params) {
                     pwm_set_chan_level(slice_green, chan_green, 0);
                     pwm_set_chan_level(slice_blue, chan_blue, 0);
                 }
-            } else if (last_sensor_data.mode == ALERT_MODE) {
+            } else if (last_sensor_data->mode == ALERT_MODE) {
                 // Pisca vermelho em modo alerta
                 if (blink_state) {
                     pwm_set_chan_level(slice_red, chan_red, 255);
-                    pwm_set_chan_level(slice_green, chan_green, last_sensor_data.trend_worsening ? 128 : 0);
+                    pwm_set_chan_level(slice_green, chan_green, last_sensor_data->trend_worsening ? 128 : 0);
                     pwm_set_chan_level(slice_blue, chan_blue, 0);
                 } else {
                     pwm_set_chan_level(slice_red, chan_red, 0);
@@ -387,33 +841,46 @@ void vLedRGBTask(void *params) {
             }
         }
         
-        vTaskDelay(pdMS_TO_TICKS(100));
+        sample_pool_release(last_ref);
+        rt_monitor_wait();
     }
 }
 
 // Tarefa de controle da matriz de LEDs - VERSÃO CORRIGIDA
 void vMatrixLedTask(void *params) {
-    alert_control_t alert_control;
+    sample_ref_t alert_ref;
     uint32_t animation_counter = 0;
     bool animation_frame = false;
     SystemMode last_displayed_mode = NORMAL_MODE;
     bool force_update = true;
     
     while (true) {
+        supervisor_beat();
         bool update_needed = false;
         
-        if (xQueueReceive(xQueueAlertControl, &alert_control, pdMS_TO_TICKS(100)) == pdTRUE) {
+        uint32_t update_sampled_us = 0;
+        uint32_t events;
+        alert_ref = mailbox_take(&mailboxes[MAILBOX_MATRIX], &events, 0);
+        if (alert_ref != SAMPLE_REF_NONE) {
+            const alert_control_t *alert_control = &sample_pool_get(alert_ref)->alert;
+            
             // Verifica se o modo mudou desde a última atualização
-            if (alert_control.mode != last_displayed_mode || alert_control.update_matrix || force_update) {
+            if (alert_control->mode != last_displayed_mode || (events & EVENT_UPDATE_MATRIX) || force_update) {
                 update_needed = true;
-                last_displayed_mode = alert_control.mode;
+                update_sampled_us = sample_pool_get(alert_ref)->sampled_us;
+                last_displayed_mode = alert_control->mode;
                 force_update = false;
             }
+            sample_pool_release(alert_ref);
+            boot_output_ready(BOOT_STAGE_MATRIX);
         }
         
+        sample_ref_t last_ref;
+        const sensor_data_t *last_sensor_data = acquire_last_sensor_data(&last_ref);
+        
         // Animação para tendência de piora
-        if (last_sensor_data.trend_worsening && 
-            (last_sensor_data.mode == ALERT_MODE || last_sensor_data.mode == CRITICAL_MODE)) {
+        if (last_sensor_data->trend_worsening && 
+            (last_sensor_data->mode == ALERT_MODE || last_sensor_data->mode == CRITICAL_MODE)) {
             animation_counter++;
             if (animation_counter >= 5) {  // A cada 500ms
                 animation_counter = 0;
@@ -427,13 +894,14 @@ void vMatrixLedTask(void *params) {
                     }
                 } else {
                     // Volta ao padrão normal do modo atual
-                    display_matrix_pattern(last_sensor_data.mode, false);
+                    display_matrix_pattern(last_sensor_data->mode, false);
                 }
             }
         } else {
             // Sem animação de tendência, verifica se precisa atualizar
             if (update_needed) {
-                display_matrix_pattern(last_sensor_data.mode, false);
+                display_matrix_pattern(last_sensor_data->mode, false);
+                record_latency(LATENCY_MATRIX, update_sampled_us);
             }
             
             // Reinicia contador de animação quando não está em tendência de piora
@@ -446,13 +914,14 @@ void vMatrixLedTask(void *params) {
         verify_counter++;
         if (verify_counter >= 20) {  // A cada 2 segundos
             verify_counter = 0;
-            if (last_displayed_mode != last_sensor_data.mode) {
+            if (last_displayed_mode != last_sensor_data->mode) {
                 // Detectou discrepância, força atualização
                 force_update = true;
             }
         }
         
-        vTaskDelay(pdMS_TO_TICKS(100));
+        sample_pool_release(last_ref);
+        rt_monitor_wait();
     }
 }
 
@@ -465,27 +934,50 @@ void vBuzzerTask(void *params) {
     pwm_init(slice_num, &config, true);
     pwm_set_gpio_level(BUZZER_PIN, 0);
     
-    alert_control_t alert_control;
+    sample_ref_t alert_ref;
     TickType_t last_sound_time = 0;
     
     while (true) {
+        supervisor_beat();
+        
         // Processa mensagens de controle de alerta
-        if (xQueueReceive(xQueueAlertControl, &alert_control, pdMS_TO_TICKS(100)) == pdTRUE) {
-            if (alert_control.update_sound) {
-                // Toca som de alerta com base no modo
-                play_alert_sound(alert_control.mode, last_sensor_data.trend_worsening);
+        uint32_t events;
+        alert_ref = mailbox_take(&mailboxes[MAILBOX_BUZZER], &events, 0);
+        if (alert_ref != SAMPLE_REF_NONE) {
+            const sensor_data_t *alert_data = sample_pool_get(alert_ref);
+            SystemMode mode = alert_data->alert.mode;
+            bool update_sound = (events & EVENT_UPDATE_SOUND) != 0;
+            bool trend_worsening = alert_data->trend_worsening;
+            uint32_t sampled_us = alert_data->sampled_us;
+            sample_pool_release(alert_ref);
+            boot_output_ready(BOOT_STAGE_BUZZER);
+            
+            if (update_sound) {
+                // Toca som de alerta com base no modo (a latência é medida no início do som).
+                // O som bloqueia por até ~5 s: o ciclo termina ao iniciá-lo, e as liberações
+                // perdidas durante a reprodução aparecem como puladas, não como prazos perdidos
+                record_latency(LATENCY_SOUND, sampled_us);
+                rt_monitor_end();
+                play_alert_sound(mode, trend_worsening);
                 last_sound_time = xTaskGetTickCount(); // Atualiza o tempo do último som
             }
         }
         
+        // Copia apenas o necessário da amostra mais recente, pois o som pode durar segundos
+        sample_ref_t last_ref;
+        const sensor_data_t *last_sensor_data = acquire_last_sensor_data(&last_ref);
+        SystemMode last_mode = last_sensor_data->mode;
+        bool last_trend_worsening = last_sensor_data->trend_worsening;
+        sample_pool_release(last_ref);
+        
         // Sons periódicos para modos de alerta
-        if (last_sensor_data.mode >= WARNING_MODE) {
+        if (last_mode >= WARNING_MODE) {
             TickType_t current_time = xTaskGetTickCount();
             TickType_t time_since_last_sound = current_time - last_sound_time;
             
             // Determina o intervalo com base no modo
             TickType_t sound_interval;
-            switch (last_sensor_data.mode) {
+            switch (last_mode) {
                 case WARNING_MODE:
                     sound_interval = pdMS_TO_TICKS(10000);  // 10 segundos
                     break;
@@ -501,12 +993,13 @@ void vBuzzerTask(void *params) {
             
             // Verifica se é hora de tocar o som novamente
             if (time_since_last_sound >= sound_interval) {
-                play_alert_sound(last_sensor_data.mode, last_sensor_data.trend_worsening);
+                rt_monitor_end();
+                play_alert_sound(last_mode, last_trend_worsening);
                 last_sound_time = current_time; // Atualiza o tempo do último som
             }
         }
         
-        vTaskDelay(pdMS_TO_TICKS(100));
+        rt_monitor_wait();
     }
 }
 
@@ -554,6 +1047,28 @@ void update_rgb_led(SystemMode mode, bool trend_worsening) {
     }
 }
 
+// Recalcula os divisores dos tons para o clk_sys atual (período de BUZZER_WRAP + 1 contagens)
+void update_tone_table(uint32_t sys_hz) {
+    for (int i = 0; i < TONE_COUNT; i++) {
+        uint32_t hz;
+        switch (i) {
+            case TONE_WARNING: hz = TONE_WARNING_HZ; break;
+            case TONE_ALERT: hz = TONE_ALERT_HZ; break;
+            case TONE_TREND: hz = TONE_TREND_HZ; break;
+            default: hz = SIREN_MIN_HZ + (i - TONE_SIREN) * SIREN_STEP_HZ; break;
+        }
+        float divider = (float)sys_hz / ((float)hz * (BUZZER_WRAP + 1));
+        tone_clkdiv[i] = divider < 1.0f ? 1.0f : (divider > 255.0f ? 255.0f : divider);
+    }
+}
+
+// Liga o buzzer no tom indicado
+static void buzzer_tone(uint slice_num, int tone) {
+    pwm_set_clkdiv(slice_num, tone_clkdiv[tone]);
+    pwm_set_wrap(slice_num, BUZZER_WRAP);
+    pwm_set_gpio_level(BUZZER_PIN, BUZZER_WRAP / 2);
+}
+
 // Função para tocar som de alerta com base no modo
 void play_alert_sound(SystemMode mode, bool trend_worsening) {
     uint slice_num = pwm_gpio_to_slice_num(BUZZER_PIN);
@@ -566,9 +1081,7 @@ void play_alert_sound(SystemMode mode, bool trend_worsening) {
             
         case WARNING_MODE:
             // Bipe único
-            pwm_set_clkdiv(slice_num, 100);
-            pwm_set_wrap(slice_num, 1000);
-            pwm_set_gpio_level(BUZZER_PIN, 500);
+            buzzer_tone(slice_num, TONE_WARNING);
             vTaskDelay(pdMS_TO_TICKS(200));
             pwm_set_gpio_level(BUZZER_PIN, 0);
             break;
@@ -576,9 +1089,7 @@ void play_alert_sound(SystemMode mode, bool trend_worsening) {
         case ALERT_MODE:
             // Dois bipes
             for (int i = 0; i < 2; i++) {
-                pwm_set_clkdiv(slice_num, 50);
-                pwm_set_wrap(slice_num, 1000);
-                pwm_set_gpio_level(BUZZER_PIN, 500);
+                buzzer_tone(slice_num, TONE_ALERT);
                 vTaskDelay(pdMS_TO_TICKS(200));
                 pwm_set_gpio_level(BUZZER_PIN, 0);
                 vTaskDelay(pdMS_TO_TICKS(200));
@@ -587,9 +1098,7 @@ void play_alert_sound(SystemMode mode, bool trend_worsening) {
             // Som adicional para tendência de piora
             if (trend_worsening) {
                 vTaskDelay(pdMS_TO_TICKS(300));
-                pwm_set_clkdiv(slice_num, 20);
-                pwm_set_wrap(slice_num, 1000);
-                pwm_set_gpio_level(BUZZER_PIN, 500);
+                buzzer_tone(slice_num, TONE_TREND);
                 vTaskDelay(pdMS_TO_TICKS(500));
                 pwm_set_gpio_level(BUZZER_PIN, 0);
             }
@@ -599,20 +1108,14 @@ void play_alert_sound(SystemMode mode, bool trend_worsening) {
             // Sirene (som oscilante)
             for (int i = 0; i < 3; i++) {
                 // Tom ascendente
-                for (int freq = 500; freq <= 2000; freq += 100) {
-                    float divider = 125000000.0f / (freq * 1000.0f);
-                    pwm_set_clkdiv(slice_num, divider);
-                    pwm_set_wrap(slice_num, 1000);
-                    pwm_set_gpio_level(BUZZER_PIN, 500);
+                for (int step = 0; step < SIREN_STEPS; step++) {
+                    buzzer_tone(slice_num, TONE_SIREN + step);
                     vTaskDelay(pdMS_TO_TICKS(50));
                 }
                 
                 // Tom descendente
-                for (int freq = 2000; freq >= 500; freq -= 100) {
-                    float divider = 125000000.0f / (freq * 1000.0f);
-                    pwm_set_clkdiv(slice_num, divider);
-                    pwm_set_wrap(slice_num, 1000);
-                    pwm_set_gpio_level(BUZZER_PIN, 500);
+                for (int step = SIREN_STEPS - 1; step >= 0; step--) {
+                    buzzer_tone(slice_num, TONE_SIREN + step);
                     vTaskDelay(pdMS_TO_TICKS(50));
                 }
             }
@@ -661,6 +1164,380 @@ void display_matrix_pattern(SystemMode mode, bool trend_worsening) {
     }
 }
 
+// Obtém a amostra mais recente publicada (ou uma amostra vazia antes da primeira leitura)
+// A referência retornada em ref deve ser liberada com sample_pool_release
+const sensor_data_t *acquire_last_sensor_data(sample_ref_t *ref) {
+    *ref = sample_pool_acquire_latest();
+    return *ref != SAMPLE_REF_NONE ? sample_pool_get(*ref) : &empty_sensor_data;
+}
+
+// Imprime o mapa de memória das estruturas da aplicação
+void report_memory_map(void) {
+    static const memory_map_entry_t entries[] = {
+        { "pool_amostras", sizeof(sensor_data_t) * SAMPLE_POOL_SIZE },
+#if HYDRO_STATIC_ALLOCATION
+        { "pilha_sensor", sizeof(sensor_stack) },
+        { "pilha_processamento", sizeof(processing_stack) },
+        { "pilha_display", sizeof(display_stack) },
+        { "pilha_led_rgb", sizeof(led_rgb_stack) },
+        { "pilha_matriz", sizeof(matrix_stack) },
+        { "pilha_buzzer", sizeof(buzzer_stack) },
+        { "pilha_i2c", sizeof(i2c_bus_stack) },
+        { "pilha_supervisor", sizeof(supervisor_stack) },
+        { "tcbs", sizeof(task_tcbs) },
+        { "filas", sizeof(sensor_queue_storage) + sizeof(queue_structs) },
+        { "caixas", sizeof(mailboxes) },
+        { "buffer_display", sizeof(display_buffer) },
+#endif
+    };
+    static_alloc_report(entries, count_of(entries));
+}
+
+// Registra o tempo decorrido desde a leitura do ADC até a atuação
+void record_latency(latency_path_t path, uint32_t sampled_us) {
+    latency_hist_record(&actuator_latency[path], time_us_32() - sampled_us);
+}
+
+// Comando "lat": histogramas de latência sensor -> atuador ("lat zera" reinicia)
+// Formato: LAT;caminho;amostras;media_us;p50_us;p90_us;p99_us;max_us;faixas...
+void cmd_latency(int argc, char **argv) {
+    for (int i = 0; i < LATENCY_PATH_COUNT; i++) {
+        latency_hist_t *hist = &actuator_latency[i];
+        
+        if (argc > 1 && strcmp(argv[1], "zera") == 0) {
+            latency_hist_reset(hist);
+            continue;
+        }
+        
+        printf("LAT;%s;%lu;%lu;%lu;%lu;%lu;%lu", latency_path_names[i], (unsigned long)hist->total,
+               (unsigned long)latency_hist_mean(hist),
+               (unsigned long)latency_hist_percentile(hist, 50.0f),
+               (unsigned long)latency_hist_percentile(hist, 90.0f),
+               (unsigned long)latency_hist_percentile(hist, 99.0f),
+               (unsigned long)hist->max_us);
+        for (int b = 0; b < LATENCY_HIST_BUCKETS; b++) {
+            printf(";%lu", (unsigned long)hist->counts[b]);
+        }
+        printf("\n");
+    }
+}
+
+#if HYDRO_TRACE
+// Comando "trace": controle e descarga do gravador de eventos do kernel
+void cmd_trace(int argc, char **argv) {
+    if (argc < 2 || strcmp(argv[1], "dump") == 0) {
+        trace_dump();
+    } else if (strcmp(argv[1], "inicia") == 0) {
+        trace_start();
+    } else if (strcmp(argv[1], "para") == 0) {
+        trace_stop();
+    } else if (strcmp(argv[1], "fila") == 0 && argc > 2) {
+        trace_set_block_queue((uint8_t)atoi(argv[2]));
+    } else {
+        printf("ERR;trace;%s\n", argv[1]);
+    }
+}
+#endif
+
+// Comando "i2c": estatísticas do gerenciador do barramento
+void cmd_i2c(int argc, char **argv) {
+    i2c_bus_stats_t stats;
+    i2c_bus_get_stats(&stats);
+    printf("I2C;%lu;%lu;%lu;%lu;%lu\n", (unsigned long)stats.transactions, (unsigned long)stats.chunks,
+           (unsigned long)stats.preemptions, (unsigned long)stats.errors,
+           (unsigned long)stats.max_high_wait_us);
+}
+
+// Comando "mbx": envios, substituições e espera de cada caixa, e descartes da fila do sensor
+void cmd_mailbox(int argc, char **argv) {
+    mailbox_stats_t stats;
+    for (int i = 0; i < MAILBOX_COUNT; i++) {
+        mailbox_get_stats(&mailboxes[i], &stats);
+        printf("MBX;%s;%lu;%lu;%lu;%lu\n", mailboxes[i].name, (unsigned long)stats.posts,
+               (unsigned long)stats.overwrites, (unsigned long)stats.takes, (unsigned long)stats.max_stale_us);
+    }
+    printf("MBX;fila_sensor;%lu\n", (unsigned long)sensor_queue_drops);
+}
+
+// Nível de clock pedido pela política: máximo no pré-alerta e nos modos de alerta,
+// intermediário com a amostragem acelerada e mínimo em repouso
+power_level_t power_level_for(const sensor_data_t *data) {
+    if (data->mode != NORMAL_MODE || data->pre_alert) {
+        return POWER_LEVEL_FULL;
+    }
+    return sensor_channels_rate() >= SENSOR_RATE_FAST ? POWER_LEVEL_MID : POWER_LEVEL_LOW;
+}
+
+// Ouvinte da troca de clk_sys: matriz (PIO), pluviômetro (PIO), tons do buzzer e UART
+void on_clock_changed(uint32_t sys_hz) {
+    pio_sm_set_clkdiv(pio, sm, ws2812_program_clkdiv(WS2812_FREQ));
+#if RAIN_GAUGE_ENABLED
+    if (rain_gauge_ready) {
+        rain_gauge_set_clkdiv(&rain_gauge);
+    }
+#endif
+    update_tone_table(sys_hz);
+#if LIB_PICO_STDIO_UART
+    // clk_peri segue clk_sys após set_sys_clock_khz
+    uart_set_baudrate(uart_default, PICO_DEFAULT_UART_BAUD_RATE);
+#endif
+}
+
+// Comando "pwr": níveis de clock, trocas, residência e corrente calibrada
+// (pwr nivel N fixa o nível, pwr auto volta à política, pwr ma N valor registra a corrente)
+void cmd_power(int argc, char **argv) {
+    if (argc >= 3 && strcmp(argv[1], "nivel") == 0) {
+        int level = atoi(argv[2]);
+        if (level < 0 || level >= POWER_LEVEL_COUNT) {
+            printf("PWR;erro;nivel\n");
+            return;
+        }
+        power_set_manual(true);
+        power_set_level((power_level_t)level);
+    } else if (argc >= 2 && strcmp(argv[1], "auto") == 0) {
+        power_set_manual(false);
+    } else if (argc >= 4 && strcmp(argv[1], "ma") == 0) {
+        power_set_idle_ma((power_level_t)atoi(argv[2]), strtof(argv[3], NULL));
+    }
+    
+    power_level_stats_t stats;
+    for (int i = 0; i < POWER_LEVEL_COUNT; i++) {
+        power_get_stats((power_level_t)i, &stats);
+        printf("PWR;%d;%lu;%lu;%lu;%lu;%lu;%lu;%.1f\n", i, (unsigned long)power_level_khz((power_level_t)i),
+               (unsigned long)power_level_mv((power_level_t)i), (unsigned long)stats.entries,
+               (unsigned long)stats.last_switch_us, (unsigned long)stats.max_switch_us,
+               (unsigned long)(stats.residency_us / 1000), (double)stats.idle_ma);
+    }
+    printf("PWR;atual;%d;%s;%.1f\n", (int)power_get_level(), power_is_manual() ? "manual" : "auto",
+           (double)power_estimated_ma());
+}
+
+// Copia o estado atual para o bloco preservado e recalcula o CRC (chamador garante exclusão)
+static void warm_seal(SystemMode mode) {
+    warm_state.mode = (uint8_t)mode;
+    warm_state.sensor_queue_drops = sensor_queue_drops;
+    warm_state.water_history = water_history;
+    warm_state.rain_history = rain_history;
+    warm_state.rules = rules;
+    sensor_channels_snapshot(&warm_state.channels);
+    warm_state_seal(&warm_state.header, WARM_STATE_MAGIC, sizeof(warm_state));
+}
+
+// Gravação periódica pela vProcessingTask; o agendador fica suspenso para que nem a
+// amostragem nem o supervisor alterem o bloco no meio do cálculo do CRC
+void warm_checkpoint(SystemMode mode) {
+    vTaskSuspendAll();
+    warm_seal(mode);
+    xTaskResumeAll();
+}
+
+// Restaura o estado de uma execução anterior (antes do agendador); devolve true se era válido
+bool warm_restore(void) {
+    bool valid = warm_state_valid(&warm_state.header, WARM_STATE_MAGIC, sizeof(warm_state)) &&
+                 sensor_channels_restore(&warm_state.channels);
+    
+    if (valid) {
+        water_history = warm_state.water_history;
+        rain_history = warm_state.rain_history;
+        history_resume(&water_history);
+        history_resume(&rain_history);
+        
+        // Regras em vigor antes do reinício; a contagem de "por S" recomeça na partida
+        for (int i = 0; i < RULE_MAX; i++) {
+            rules.rules[i] = warm_state.rules.rules[i];
+            if (rules.rules[i].length > 0 && !rule_verify(&rules.rules[i])) {
+                rule_clear(&rules.rules[i]);
+            }
+            rules.rules[i].armed = false;
+            rules.rules[i].active = false;
+            rules.rules[i].true_since_ms = 0;
+        }
+        sensor_queue_drops = warm_state.sensor_queue_drops;
+        warm_state.restarts++;
+        if (warm_state.fault_task[0] != '\0') {
+            memcpy(last_fault_task, warm_state.fault_task, sizeof(last_fault_task));
+        }
+    } else {
+        memset(&warm_state, 0, sizeof(warm_state));
+    }
+    if (watchdog_caused_reboot()) {
+        warm_state.watchdog_resets++;
+    }
+    printf("BOOT;%s;%lu;%lu;%u;%s\n", valid ? "quente" : "frio", (unsigned long)warm_state.restarts,
+           (unsigned long)warm_state.watchdog_resets, warm_state.mode, last_fault_task);
+    
+    memset(warm_state.fault_task, 0, sizeof(warm_state.fault_task));
+    warm_seal((SystemMode)warm_state.mode);
+    return valid;
+}
+
+// Gancho do supervisor: registra a tarefa que travou antes do reinício pelo watchdog
+void on_task_fault(const char *task_name) {
+    vTaskSuspendAll();
+    strncpy(warm_state.fault_task, task_name, sizeof(warm_state.fault_task) - 1);
+    warm_state_seal(&warm_state.header, WARM_STATE_MAGIC, sizeof(warm_state));
+    xTaskResumeAll();
+}
+
+// Comando "sup": prazo, tempo desde o último sinal e maior intervalo de cada tarefa
+// Formato: SUP;tarefa;prazo_ms;idade_ms;max_ms / SUP;boot;quente|frio;reinicios;watchdog;ultima_falha
+void cmd_supervisor(int argc, char **argv) {
+    supervisor_entry_t entry;
+    for (uint8_t i = 0; supervisor_get(i, &entry); i++) {
+        printf("SUP;%s;%lu;%lu;%lu\n", entry.name, (unsigned long)entry.timeout_ms,
+               (unsigned long)entry.age_ms, (unsigned long)entry.max_age_ms);
+    }
+    printf("SUP;boot;%s;%lu;%lu;%s\n", warm_start ? "quente" : "frio", (unsigned long)warm_state.restarts,
+           (unsigned long)warm_state.watchdog_resets, last_fault_task);
+}
+
+// Prioridades por prazo: cada tarefa da faixa derivada fica um nível acima de cada
+// (prazo, período) distinto mais folgado que o seu, a partir da prioridade 1
+void assign_priorities(void) {
+    for (size_t i = 0; i < count_of(tasks); i++) {
+        if (tasks[i].priority != PRIORITY_BY_DEADLINE) {
+            continue;
+        }
+        UBaseType_t priority = 1;
+        for (size_t j = 0; j < count_of(tasks); j++) {
+            if (tasks[j].priority == PRIORITY_BY_DEADLINE && j != i &&
+                (tasks[j].deadline_ms > tasks[i].deadline_ms ||
+                 (tasks[j].deadline_ms == tasks[i].deadline_ms && tasks[j].period_ms > tasks[i].period_ms))) {
+                // Conta cada par (prazo, período) uma única vez
+                bool repeated = false;
+                for (size_t k = 0; k < j && !repeated; k++) {
+                    repeated = tasks[k].priority == PRIORITY_BY_DEADLINE &&
+                               tasks[k].deadline_ms == tasks[j].deadline_ms &&
+                               tasks[k].period_ms == tasks[j].period_ms;
+                }
+                priority += repeated ? 0 : 1;
+            }
+        }
+        tasks[i].priority = priority;
+    }
+}
+
+// Comando "rt": prioridade, período, prazo, ciclos, prazos e liberações perdidos,
+// maior resposta e maior jitter de cada tarefa ("rt zera" reinicia os contadores)
+// Formato: RT;tarefa;prioridade;periodo_ms;prazo_ms;ciclos;perdidos;pulados;resposta_max_us;jitter_max_us
+void cmd_realtime(int argc, char **argv) {
+    rt_monitor_entry_t entry;
+    
+    if (argc > 1 && strcmp(argv[1], "zera") == 0) {
+        rt_monitor_reset();
+        return;
+    }
+    for (uint8_t i = 0; rt_monitor_get(i, &entry); i++) {
+        UBaseType_t priority = 0;
+        for (size_t t = 0; t < count_of(tasks); t++) {
+            if (tasks[t].name == entry.name) {
+                priority = tasks[t].priority;
+            }
+        }
+        printf("RT;%s;%lu;%lu;%lu;%lu;%lu;%lu;%lu;%lu\n", entry.name, (unsigned long)priority,
+               (unsigned long)entry.period_ms, (unsigned long)entry.deadline_ms, (unsigned long)entry.cycles,
+               (unsigned long)entry.misses, (unsigned long)entry.skipped,
+               (unsigned long)entry.max_response_us, (unsigned long)entry.max_jitter_us);
+    }
+}
+
+// Política dos canais: regras do local sobre o estado consolidado (contexto da vSensorTask)
+void apply_rules(sensor_data_t *data, uint32_t now_ms) {
+    uint32_t start = time_us_32();
+    rules_active = rule_set_evaluate(&rules, data, now_ms);
+    uint32_t elapsed = time_us_32() - start;
+    if (elapsed > rules_eval_max_us) {
+        rules_eval_max_us = elapsed;
+    }
+}
+
+// Comando "regra": lista, carrega ou apaga regras de alerta sem regravar o firmware
+//   regra                              -> RULE;N;acao;por_s;ativa;disparos;programa pós-fixo
+//                                         RULE;custo;ativas;max_us
+//   regra N nivel > 60 e nivel.taxa > 2 por 30 alerta
+//   regra N apaga
+void cmd_rules(int argc, char **argv) {
+    rule_t rule;
+    
+    if (argc < 2) {
+        char program[128];
+        for (int i = 0; i < RULE_MAX; i++) {
+            vTaskSuspendAll();
+            rule = rules.rules[i];
+            xTaskResumeAll();
+            if (rule.length == 0) {
+                continue;
+            }
+            rule_format(&rule, program, sizeof(program));
+            printf("RULE;%d;%s;%u;%d;%lu;%s\n", i, rule_action_name(rule.action), rule.hold_s,
+                   rule.active ? 1 : 0, (unsigned long)rule.fired, program);
+        }
+        printf("RULE;custo;%u;%lu\n", rules_active, (unsigned long)rules_eval_max_us);
+        return;
+    }
+    
+    char *end;
+    long slot = strtol(argv[1], &end, 10);
+    if (*end != '\0' || slot < 0 || slot >= RULE_MAX || argc < 3) {
+        printf("ERR;regra;posicao\n");
+        return;
+    }
+    if (argc == 3 && strcmp(argv[2], "apaga") == 0) {
+        rule_clear(&rule);
+    } else {
+        int error_token;
+        if (!rule_compile(&rule, (const char *const *)&argv[2], argc - 2, &error_token)) {
+            printf("ERR;regra;%s\n", error_token < argc - 2 ? argv[2 + error_token] : "incompleta");
+            return;
+        }
+    }
+    
+    // Troca a regra inteira entre duas avaliações
+    vTaskSuspendAll();
+    rules.rules[slot] = rule;
+    xTaskResumeAll();
+    printf("RULE;%ld;ok\n", slot);
+}
+
+// Comando "tlm": formato da telemetria (tlm bin|texto)
+void cmd_telemetry(int argc, char **argv) {
+    if (argc >= 2 && strcmp(argv[1], "bin") == 0) {
+        telemetry_binary = true;
+    } else if (argc >= 2 && strcmp(argv[1], "texto") == 0) {
+        telemetry_binary = false;
+    }
+    printf("TLM;formato;%s;%u\n", telemetry_binary ? "bin" : "texto", telemetry_sequence);
+}
+
+void boot_mark(boot_stage_t stage) {
+    boot_profile_mark(&boot_profile, (uint8_t)stage, time_us_32());
+}
+
+// Primeira amostra aplicada em uma saída de alarme; com as três prontas, libera a
+// inicialização do display
+void boot_output_ready(boot_stage_t stage) {
+    if (boot_profile_mark(&boot_profile, (uint8_t)stage, time_us_32()) &&
+        boot_profile_reached(&boot_profile, BOOT_ALARM_STAGES) && boot_display_waiting) {
+        for (size_t i = 0; i < count_of(tasks); i++) {
+            if (tasks[i].function == vDisplayTask) {
+                xTaskNotifyGiveIndexed(tasks[i].handle, BOOT_NOTIFY_INDEX);
+            }
+        }
+    }
+}
+
+// Comando "boot": instante de cada etapa desde o reset e tempo até a capacidade de alerta
+// Formato: BOOT;etapa;nome;us (-1 = ainda não atingida) / BOOT;tta;us;orcamento_us;ok|excedido|pendente
+void cmd_boot(int argc, char **argv) {
+    for (int i = 0; i < BOOT_STAGE_COUNT; i++) {
+        printf("BOOT;etapa;%s;%ld\n", boot_stage_names[i],
+               boot_profile.reached[i] ? (long)boot_profile.us[i] : -1L);
+    }
+    uint32_t tta = boot_profile_latest(&boot_profile, BOOT_ALARM_STAGES);
+    printf("BOOT;tta;%lu;%lu;%s\n", (unsigned long)tta, (unsigned long)BOOT_TTA_BUDGET_US,
+           tta == 0 ? "pendente" : tta <= BOOT_TTA_BUDGET_US ? "ok" : "excedido");
+}
+
 // Converte componentes RGB em GRB para o WS2812
 uint32_t urgb_u32(uint8_t r, uint8_t g, uint8_t b) {
     return ((uint32_t) (r) << 8) | ((uint32_t) (g) << 16) | (uint32_t) (b);
@@ -671,49 +1548,203 @@ void put_pixel(uint32_t pixel_grb) {
     pio_sm_put_blocking(pio, sm, pixel_grb << 8u);
 }
 
-// Inicialização do hardware
+// Envia uma linha de telemetria pela saída padrão (USB/UART)
+// Formato: TLM;tempo_ms;modo;t_critico_s;pre_alerta;canais;nome=valor/taxa;...
+// ou TLB;quadro binário em hexadecimal (lib/telemetry_frame.h), que não sofre a
+// conversão de fim de linha da saída padrão
+void send_telemetry(const sensor_data_t *data) {
+    if (telemetry_binary) {
+        telemetry_frame_t frame;
+        uint8_t buffer[TELEMETRY_FRAME_MAX];
+        telemetry_frame_from_sample(&frame, data, STATION_ID, telemetry_sequence++);
+        size_t length = telemetry_frame_encode(&frame, buffer);
+        printf("TLB;");
+        for (size_t i = 0; i < length; i++) {
+            printf("%02x", buffer[i]);
+        }
+        printf("\n");
+        return;
+    }
+    
+    printf("TLM;%lu;%d;%ld;%d;%u", (unsigned long)data->timestamp, (int)data->mode,
+           (long)data->time_to_critical, data->pre_alert ? 1 : 0, data->channel_count);
+    for (int i = 0; i < data->channel_count; i++) {
+        printf(";%s=%.1f/%.2f", sensor_channel_get(i)->name, data->value[i], data->rate[i]);
+    }
+    printf("\n");
+}
+
+// Leitura de um canal do ADC em porcentagem do fundo de escala
+float read_adc_percent(void *ctx) {
+    const adc_channel_t *adc = ctx;
+    adc_select_input(adc->input);
+    uint16_t raw = adc_read();
+    return (float)((raw * 100) / 4095);
+}
+
+// Registra os canais de sensor da estação
+void register_sensor_channels(void) {
+    // Nível da água (eixo X do joystick)
+    ch_water = sensor_channel_register(&(sensor_channel_t){
+        .name = "nivel",
+        .read = read_adc_percent,
+        .ctx = &adc_water,
+        .period_ms = SENSOR_PERIOD_MS,
+        .adaptive = true,
+        .warning = WATER_LEVEL_WARNING,
+        .alert = WATER_LEVEL_ALERT,
+        .critical = WATER_LEVEL_CRITICAL,
+        .predicts = true,
+        .worsening_rate = WATER_RATE_WORSENING,
+        .confirm_delta = FILTER_CONFIRM_DELTA,
+    });
+    hampel_filter_init(&water_filter, FILTER_WINDOW, FILTER_HAMPEL_K, FILTER_MIN_DEVIATION);
+    sensor_channel_add_filter(ch_water, hampel_filter_apply, &water_filter);
+    
+    // Volume de chuva (eixo Y do joystick)
+    ch_rain = sensor_channel_register(&(sensor_channel_t){
+        .name = "chuva",
+        .read = read_adc_percent,
+        .ctx = &adc_rain,
+        .period_ms = SENSOR_PERIOD_MS,
+        .adaptive = true,
+        .warning = RAIN_VOLUME_WARNING,
+        .alert = RAIN_VOLUME_ALERT,
+        .critical = RAIN_VOLUME_CRITICAL,
+        .worsening_rate = RAIN_RATE_WORSENING,
+        .confirm_delta = FILTER_CONFIRM_DELTA,
+    });
+    hampel_filter_init(&rain_filter, FILTER_WINDOW, FILTER_HAMPEL_K, FILTER_MIN_DEVIATION);
+    sensor_channel_add_filter(ch_rain, hampel_filter_apply, &rain_filter);
+    
+#if RAIN_GAUGE_ENABLED
+    // Intensidade de chuva do pluviômetro de báscula (mm/h)
+    if (rain_gauge_ready) {
+        sensor_channel_register(&(sensor_channel_t){
+            .name = "pluvio",
+            .read = rain_gauge_read_intensity,
+            .ctx = &rain_gauge,
+            .period_ms = RAIN_GAUGE_PERIOD_MS,
+            .warning = RAIN_INTENSITY_WARNING,
+            .alert = RAIN_INTENSITY_ALERT,
+            .critical = RAIN_INTENSITY_CRITICAL,
+            .worsening_rate = RAIN_INTENSITY_WORSENING,
+        });
+    }
+#endif
+}
+
+// Inicialização do hardware em etapas: primeiro o que a primeira amostra e as saídas
+// de alarme usam, depois a saída padrão e o barramento do display
 void init_hardware(void) {
-    stdio_init_all();
+    // ADC dos canais do joystick (uma única vez, antes da primeira amostra)
+    adc_init();
+    adc_gpio_init(ADC_JOYSTICK_X);
+    adc_gpio_init(ADC_JOYSTICK_Y);
     
     // Inicializa PIO para WS2812
+    pio_sm_claim(pio, sm);
     uint offset = pio_add_program(pio, &ws2812_program);
-    ws2812_program_init(pio, sm, offset, WS2812_PIN, 800000, false);
+    ws2812_program_init(pio, sm, offset, WS2812_PIN, WS2812_FREQ, false);
     
     // Limpa a matriz de LEDs
     for (int i = 0; i < NUM_PIXELS; i++) {
         put_pixel(0);
     }
-}
-
-// Modo BOOTSEL com botão B
-void gpio_irq_handler(uint gpio, uint32_t events)
-{
-    reset_usb_boot(0, 0);
+    
+#if RAIN_GAUGE_ENABLED
+    // Captura de pulsos do pluviômetro em outra máquina de estados da mesma PIO
+    rain_gauge_ready = rain_gauge_init(&rain_gauge, pio, RAIN_GAUGE_PIN, RAIN_GAUGE_MM_PER_TIP);
+#endif
+    
+    // Escalonamento de clock: periféricos reconfigurados a cada troca de clk_sys
+    power_init();
+    update_tone_table(clock_get_hz(clk_sys));
+    power_register_listener(on_clock_changed);
+    power_register_listener(i2c_bus_clock_changed);
+    power_set_guard(i2c_bus_clock_guard);
+    boot_mark(BOOT_STAGE_ALARM_HW);
+    
+    stdio_init_all();
+    boot_mark(BOOT_STAGE_STDIO);
+    
+    // Barramento I2C compartilhado entre o display e sensores (o display é configurado
+    // pela própria tarefa, depois das saídas de alarme)
+    i2c_bus_init(I2C_PORT, 400 * 1000, I2C_SDA, I2C_SCL);
 }
 
 int main()
 {
-    // Ativa BOOTSEL via botão
-    gpio_init(BTN_B);
-    gpio_set_dir(BTN_B, GPIO_IN);
-    gpio_pull_up(BTN_B);
-    gpio_set_irq_enabled_with_callback(BTN_B, GPIO_IRQ_EDGE_FALL, true, &gpio_irq_handler);
-
+    boot_mark(BOOT_STAGE_MAIN);
+    
     // Inicializa hardware
     init_hardware();
     
+    // Registra os canais de sensor antes de iniciar as tarefas
+    register_sensor_channels();
+    
+    // Histogramas de latência e comandos de consulta
+    for (int i = 0; i < LATENCY_PATH_COUNT; i++) {
+        latency_hist_reset(&actuator_latency[i]);
+    }
+    console_register("lat", "latencia sensor-atuador (lat zera)", cmd_latency);
+    console_register("i2c", "estatisticas do barramento I2C", cmd_i2c);
+    console_register("pwr", "clock dinamico (pwr nivel N|auto|ma N valor)", cmd_power);
+    console_register("sup", "supervisor de tarefas e reinicios", cmd_supervisor);
+    console_register("rt", "prazos, periodos e jitter das tarefas (rt zera)", cmd_realtime);
+    console_register("mbx", "caixas de ultimo valor e descartes", cmd_mailbox);
+    console_register("tlm", "formato da telemetria (tlm bin|texto)", cmd_telemetry);
+    console_register("boot", "etapas da partida e tempo ate o alerta", cmd_boot);
+    console_register("regra", "regras de alerta (regra N expr [por S] acao|apaga)", cmd_rules);
+    
+    // Regras do local: nenhuma na partida a frio (só os limiares dos canais), as
+    // carregadas pelo console são preservadas no reinício a quente
+    sensor_channels_set_policy(apply_rules);
+    
+    // Inicializa o pool de amostras e os históricos
+    sample_pool_init();
+    history_init(&water_history, HISTORY_PERIOD_MS);
+    history_init(&rain_history, HISTORY_PERIOD_MS);
+    
+    // Reinício a quente: tendências, nível de amostragem, históricos e contadores da execução anterior
+    warm_start = warm_restore();
+    
     // Cria filas para comunicação entre tarefas
-    xQueueSensorData = xQueueCreate(5, sizeof(sensor_data_t));
-    xQueueAlertControl = xQueueCreate(5, sizeof(alert_control_t));
-    xQueueDisplayData = xQueueCreate(3, sizeof(sensor_data_t));
-    
-    // Cria tarefas
-    xTaskCreate(vSensorTask, "Sensor Task", 256, NULL, 3, NULL);
-    xTaskCreate(vProcessingTask, "Processing Task", 256, NULL, 2, NULL);
-    xTaskCreate(vDisplayTask, "Display Task", 512, NULL, 1, NULL);
-    xTaskCreate(vLedRGBTask, "LED RGB Task", 256, NULL, 1, NULL);
-    xTaskCreate(vMatrixLedTask, "Matrix LED Task", 256, NULL, 1, NULL);
-    xTaskCreate(vBuzzerTask, "Buzzer Task", 256, NULL, 1, NULL);
+    xQueueSensorData = static_alloc_queue(QUEUE_SENSOR_LENGTH, sizeof(sample_ref_t),
+                                          STATIC_MEMORY(sensor_queue_storage), STATIC_MEMORY(&queue_structs[0]));
+    instr_register_queue(INSTR_QUEUE_SENSOR, "sensor", xQueueSensorData, QUEUE_SENSOR_LENGTH);
+    for (int i = 0; i < MAILBOX_COUNT; i++) {
+        mailbox_init(&mailboxes[i], mailbox_names[i]);
+    }
+#if HYDRO_TRACE
+    trace_register_queue(xQueueSensorData, 1, "sensor");
+    for (int i = 0; i < MAILBOX_COUNT; i++) {
+        trace_register_queue(mailboxes[i].signal, (uint8_t)(i + 2), mailbox_names[i]);
+    }
+    trace_set_block_queue(2);
+    console_register("trace", "gravador de eventos (dump|inicia|para|fila N)", cmd_trace);
+#endif
+    
+    // Cria tarefas com as prioridades derivadas dos prazos
+    assign_priorities();
+    for (size_t i = 0; i < count_of(tasks); i++) {
+        tasks[i].handle = static_alloc_task(tasks[i].function, tasks[i].name, tasks[i].stack_words,
+                                            tasks[i].priority, tasks[i].stack, tasks[i].tcb);
+        if (tasks[i].heartbeat_ms > 0) {
+            supervisor_watch(tasks[i].handle, tasks[i].name, tasks[i].heartbeat_ms);
+        }
+        if (tasks[i].period_ms > 0) {
+            rt_monitor_watch(tasks[i].handle, tasks[i].name, tasks[i].period_ms, tasks[i].deadline_ms);
+        }
+        if (tasks[i].function == vI2CBusTask) {
+            i2c_bus_attach(tasks[i].handle);
+        }
+    }
+    supervisor_set_fault_hook(on_task_fault);
+    
+    // O mapa de memória e o perfil da partida são enviados pela vProcessingTask
+    // depois do primeiro alerta, sem atrasar a partida
+    boot_mark(BOOT_STAGE_SCHEDULER);
     
     // Inicia o agendador
     vTaskStartScheduler();
@@ -63,24 +63,56 @@
  #define configUSE_NEWLIB_REENTRANT              0
  #define configENABLE_BACKWARD_COMPATIBILITY     0
  #define configNUM_THREAD_LOCAL_STORAGE_POINTERS 5
+ /* Índice 0: espera de transações do I2C; índice 1: liberação do display na partida */
+ #define configTASK_NOTIFICATION_ARRAY_ENTRIES   2
  
  /* System */
  #define configSTACK_DEPTH_TYPE                  uint32_t
  #define configMESSAGE_BUFFER_LENGTH_TYPE        size_t
  
  /* Memory allocation related definitions. */
+ /* HYDRO_STATIC_ALLOCATION (opção do CMake) cria tarefas, filas e buffers
+  * estaticamente e remove o heap do FreeRTOS (heap_4 não é ligado). */
+ #ifndef HYDRO_STATIC_ALLOCATION
+ #define HYDRO_STATIC_ALLOCATION                 0
+ #endif
+ #if HYDRO_STATIC_ALLOCATION
+ #define configSUPPORT_STATIC_ALLOCATION         1
+ #define configSUPPORT_DYNAMIC_ALLOCATION        0
+ #else
  #define configSUPPORT_STATIC_ALLOCATION         0
  #define configSUPPORT_DYNAMIC_ALLOCATION        1
+ #endif
  #define configTOTAL_HEAP_SIZE                   (128*1024)
  #define configAPPLICATION_ALLOCATED_HEAP        0
  
  /* Hook function related definitions. */
+ /* HYDRO_INSTRUMENTATION (opção do CMake) liga a verificação de pilha, as
+  * estatísticas de tempo de execução e os relatórios de lib/instrumentation.c */
+ #ifndef HYDRO_INSTRUMENTATION
+ #define HYDRO_INSTRUMENTATION                   0
+ #endif
+ #if HYDRO_INSTRUMENTATION
+ #define configCHECK_FOR_STACK_OVERFLOW          2
+ #else
  #define configCHECK_FOR_STACK_OVERFLOW          0
+ #endif
  #define configUSE_MALLOC_FAILED_HOOK            0
  #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
  
  /* Run time and task stats gathering related definitions. */
+ #if HYDRO_INSTRUMENTATION
+ /* Contador de tempo de execução no temporizador de 1 MHz do RP2040 */
+ #ifndef __ASSEMBLER__
+ #include <stdint.h>
+ extern uint32_t instr_runtime_counter(void);
+ #endif
+ #define configGENERATE_RUN_TIME_STATS           1
+ #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+ #define portGET_RUN_TIME_COUNTER_VALUE()        instr_runtime_counter()
+ #else
  #define configGENERATE_RUN_TIME_STATS           0
+ #endif
  #define configUSE_TRACE_FACILITY                1
  #define configUSE_STATS_FORMATTING_FUNCTIONS    0
  
@@ -134,5 +166,9 @@
  #define INCLUDE_xQueueGetMutexHolder            1
  
  /* A header file that defines trace macro can be included here. */
+ /* HYDRO_TRACE (opção do CMake) grava trocas de contexto e operações de fila */
+ #if defined(HYDRO_TRACE) && HYDRO_TRACE && !defined(__ASSEMBLER__)
+ #include "trace_recorder.h"
+ #endif
  
  #endif /* FREERTOS_CONFIG_H */
\ No newline at end of file
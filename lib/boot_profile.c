@@ -0,0 +1,33 @@
+#include "boot_profile.h"
+
+bool boot_profile_mark(boot_profile_t *profile, uint8_t stage, uint32_t now_us) {
+    if (stage >= BOOT_PROFILE_MAX_STAGES || profile->reached[stage]) {
+        return false;
+    }
+    profile->us[stage] = now_us;
+    profile->reached[stage] = true;
+    return true;
+}
+
+bool boot_profile_reached(const boot_profile_t *profile, uint32_t stages) {
+    for (uint8_t i = 0; i < BOOT_PROFILE_MAX_STAGES; i++) {
+        if ((stages & (1u << i)) && !profile->reached[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t boot_profile_latest(const boot_profile_t *profile, uint32_t stages) {
+    uint32_t latest = 0;
+
+    if (!boot_profile_reached(profile, stages)) {
+        return 0;
+    }
+    for (uint8_t i = 0; i < BOOT_PROFILE_MAX_STAGES; i++) {
+        if ((stages & (1u << i)) && profile->us[i] > latest) {
+            latest = profile->us[i];
+        }
+    }
+    return latest;
+}
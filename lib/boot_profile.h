@@ -0,0 +1,26 @@
+#ifndef BOOT_PROFILE_H
+#define BOOT_PROFILE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Perfil da partida: instante (µs desde o reset) em que cada etapa foi atingida pela
+// primeira vez. Cada etapa é marcada por uma única tarefa, então não há trava. Os
+// instantes vêm do chamador (time_us_32), e o módulo também roda no host.
+#define BOOT_PROFILE_MAX_STAGES 16
+
+typedef struct {
+    uint32_t us[BOOT_PROFILE_MAX_STAGES];
+    volatile bool reached[BOOT_PROFILE_MAX_STAGES];
+} boot_profile_t;
+
+// Grava o instante da etapa; devolve true apenas na primeira marcação
+bool boot_profile_mark(boot_profile_t *profile, uint8_t stage, uint32_t now_us);
+
+// Todas as etapas do conjunto (bit = etapa) já foram atingidas
+bool boot_profile_reached(const boot_profile_t *profile, uint32_t stages);
+
+// Instante da última etapa do conjunto a ser atingida (0 se alguma ainda falta)
+uint32_t boot_profile_latest(const boot_profile_t *profile, uint32_t stages);
+
+#endif
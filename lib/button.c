@@ -0,0 +1,47 @@
+#include "pico/stdlib.h"
+#include "button.h"
+
+// Configura o pino com pull-up: o botão fecha contato para GND
+void button_init(button_t *button, uint8_t pin, uint32_t long_ms) {
+    gpio_init(pin);
+    gpio_set_dir(pin, GPIO_IN);
+    gpio_pull_up(pin);
+
+    button->pin = pin;
+    button->long_ms = long_ms;
+    button->raw = false;
+    button->pressed = false;
+    button->long_sent = false;
+    button->raw_changed_ms = 0;
+    button->pressed_ms = 0;
+}
+
+// Lógica de debounce e temporização, separada da leitura do pino
+button_event_t button_update(button_t *button, bool raw_pressed, uint32_t now_ms) {
+    if (raw_pressed != button->raw) {
+        button->raw = raw_pressed;
+        button->raw_changed_ms = now_ms;
+        return BUTTON_EVENT_NONE;
+    }
+
+    // Estado novo só é aceito depois de estável por BUTTON_DEBOUNCE_MS
+    if (raw_pressed != button->pressed && now_ms - button->raw_changed_ms >= BUTTON_DEBOUNCE_MS) {
+        button->pressed = raw_pressed;
+        if (raw_pressed) {
+            button->pressed_ms = now_ms;
+            button->long_sent = false;
+            return BUTTON_EVENT_NONE;
+        }
+        return button->long_sent ? BUTTON_EVENT_NONE : BUTTON_EVENT_SHORT;
+    }
+
+    if (button->pressed && !button->long_sent && now_ms - button->pressed_ms >= button->long_ms) {
+        button->long_sent = true;
+        return BUTTON_EVENT_LONG;
+    }
+    return BUTTON_EVENT_NONE;
+}
+
+button_event_t button_poll(button_t *button, uint32_t now_ms) {
+    return button_update(button, !gpio_get(button->pin), now_ms);
+}
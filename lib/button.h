@@ -0,0 +1,32 @@
+#ifndef BUTTON_H
+#define BUTTON_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Botão amostrado periodicamente (sem interrupção), com debounce por tempo e
+// detecção de pressão longa. O evento curto sai na soltura; o longo sai uma única
+// vez quando o botão completa long_ms pressionado.
+#define BUTTON_DEBOUNCE_MS 30
+
+typedef enum {
+    BUTTON_EVENT_NONE,
+    BUTTON_EVENT_SHORT,
+    BUTTON_EVENT_LONG
+} button_event_t;
+
+typedef struct {
+    uint8_t pin;
+    uint32_t long_ms;          // Duração da pressão longa
+    bool raw;                  // Última leitura bruta (true = pressionado)
+    bool pressed;              // Estado após o debounce
+    bool long_sent;            // Pressão longa já sinalizada nesta pressão
+    uint32_t raw_changed_ms;   // Instante da última mudança da leitura bruta
+    uint32_t pressed_ms;       // Instante em que a pressão foi confirmada
+} button_t;
+
+void button_init(button_t *button, uint8_t pin, uint32_t long_ms);
+button_event_t button_update(button_t *button, bool raw_pressed, uint32_t now_ms);
+button_event_t button_poll(button_t *button, uint32_t now_ms);
+
+#endif
@@ -0,0 +1,73 @@
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "console.h"
+
+typedef struct {
+    const char *name;
+    const char *help;
+    console_handler_t handler;
+} console_command_t;
+
+static console_command_t commands[CONSOLE_MAX_COMMANDS];
+static int command_count = 0;
+static char line[CONSOLE_LINE_MAX];
+static int line_length = 0;
+
+bool console_register(const char *name, const char *help, console_handler_t handler) {
+    if (command_count >= CONSOLE_MAX_COMMANDS) {
+        return false;
+    }
+    commands[command_count].name = name;
+    commands[command_count].help = help;
+    commands[command_count].handler = handler;
+    command_count++;
+    return true;
+}
+
+// Separa a linha em argumentos e chama o comando correspondente
+void console_execute(char *text) {
+    char *argv[CONSOLE_MAX_ARGS];
+    int argc = 0;
+
+    for (char *token = strtok(text, " \t"); token != NULL && argc < CONSOLE_MAX_ARGS; token = strtok(NULL, " \t")) {
+        argv[argc++] = token;
+    }
+    if (argc == 0) {
+        return;
+    }
+
+    if (strcmp(argv[0], "ajuda") == 0) {
+        for (int i = 0; i < command_count; i++) {
+            printf("CMD;%s;%s\n", commands[i].name, commands[i].help);
+        }
+        return;
+    }
+
+    for (int i = 0; i < command_count; i++) {
+        if (strcmp(argv[0], commands[i].name) == 0) {
+            commands[i].handler(argc, argv);
+            return;
+        }
+    }
+    printf("ERR;comando desconhecido;%s\n", argv[0]);
+}
+
+// Acumula um caractere; executa a linha ao receber fim de linha
+void console_feed(char c) {
+    if (c == '\r' || c == '\n') {
+        line[line_length] = '\0';
+        line_length = 0;
+        console_execute(line);
+    } else if (line_length < CONSOLE_LINE_MAX - 1) {
+        line[line_length++] = c;
+    }
+}
+
+// Consome os caracteres disponíveis sem bloquear
+void console_poll(void) {
+    int c;
+    while ((c = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT) {
+        console_feed((char)c);
+    }
+}
@@ -0,0 +1,18 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include <stdbool.h>
+
+// Canal de comandos em texto pela entrada padrão (USB/UART), uma linha por comando
+#define CONSOLE_LINE_MAX 96
+#define CONSOLE_MAX_ARGS 20
+#define CONSOLE_MAX_COMMANDS 16
+
+typedef void (*console_handler_t)(int argc, char **argv);
+
+bool console_register(const char *name, const char *help, console_handler_t handler);
+void console_feed(char c);
+void console_poll(void);
+void console_execute(char *line);
+
+#endif
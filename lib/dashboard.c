@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include "dashboard.h"
+#include "prediction.h"
+
+// Desenha o rótulo com a porcentagem e a barra de progresso de um canal
+static void draw_bar(ssd1306_t *display, const char *label, uint16_t percent, uint8_t y) {
+    char buffer[32];
+
+    snprintf(buffer, sizeof(buffer), "%s: %d%%", label, percent);
+    ssd1306_draw_string(display, buffer, 0, y);
+
+    ssd1306_rect(display, 64, y, 60, 8, true, false);
+    uint8_t bar_width = (percent * 58) / 100;
+    if (bar_width > 0) {
+        ssd1306_rect(display, 64, y + 1, bar_width, 6, true, true);
+    }
+}
+
+void dashboard_render(ssd1306_t *display, const sensor_data_t *data, int ch_water, int ch_rain) {
+    char buffer[32];
+
+    // Limpa o display
+    ssd1306_fill(display, false);
+
+    // Tempo estimado até o nível crítico
+    if (data->time_to_critical == PREDICTION_NONE) {
+        snprintf(buffer, sizeof(buffer), "Critico: --");
+    } else if (data->time_to_critical >= 3600) {
+        snprintf(buffer, sizeof(buffer), "Critico: >1h");
+    } else if (data->time_to_critical >= 60) {
+        snprintf(buffer, sizeof(buffer), "Critico: %ldm%02lds", (long)(data->time_to_critical / 60),
+                 (long)(data->time_to_critical % 60));
+    } else {
+        snprintf(buffer, sizeof(buffer), "Critico: %lds", (long)data->time_to_critical);
+    }
+    ssd1306_draw_string(display, buffer, 0, 0);
+
+    // Nível de água e volume de chuva com barras de progresso
+    draw_bar(display, "Nivel", dashboard_percent(data->value[ch_water]), 16);
+    draw_bar(display, "Chuva", dashboard_percent(data->value[ch_rain]), 32);
+
+    // Status do sistema
+    ssd1306_line(display, 0, 48, 127, 48, true);
+    switch (data->mode) {
+        case NORMAL_MODE:
+            ssd1306_draw_string(display, data->pre_alert ? "PRE-ALERTA!" : "STATUS: NORMAL", 0, 50);
+            break;
+        case WARNING_MODE:
+            ssd1306_draw_string(display, data->pre_alert ? "PRE-ALERTA!" : "STATUS: ATENCAO!", 0, 50);
+            break;
+        case ALERT_MODE:
+            ssd1306_draw_string(display, "STATUS: ALERTA!", 0, 50);
+            break;
+        case CRITICAL_MODE:
+            ssd1306_draw_string(display, "EVACUACAO IMEDIATA!", 0, 50);
+            break;
+    }
+}
+
+void dashboard_draw_history(ssd1306_t *display, const sparkline_t *water, const sparkline_t *rain) {
+    sparkline_draw(display, water, DASHBOARD_WATER_GRAPH_PAGE);
+    sparkline_draw(display, rain, DASHBOARD_RAIN_GRAPH_PAGE);
+}
+
+void dashboard_render_history(ssd1306_t *display, const sparkline_t *water, const sparkline_t *rain,
+                              uint32_t period_ms) {
+    char buffer[32];
+
+    ssd1306_fill(display, false);
+    snprintf(buffer, sizeof(buffer), "HIST %lumin", (unsigned long)(period_ms * SPARKLINE_COLUMNS / 60000));
+    ssd1306_draw_string(display, buffer, 0, 0);
+
+    ssd1306_draw_string(display, "Nivel", 0, 12);
+    sparkline_draw(display, water, 3);
+    ssd1306_draw_string(display, "Chuva", 0, 36);
+    sparkline_draw(display, rain, 6);
+}
+
+// Linha de estatísticas: mínimo, média e máximo do histórico
+static void draw_stats_line(ssd1306_t *display, const char *label, const history_t *history, uint8_t y) {
+    char buffer[32];
+    history_stats_t stats;
+
+    history_stats(history, &stats);
+    ssd1306_draw_string(display, label, 0, y);
+    snprintf(buffer, sizeof(buffer), "%u/%u/%u%%", stats.min, (unsigned)(stats.mean + 0.5f), stats.max);
+    ssd1306_draw_string(display, buffer, 0, y + 10);
+}
+
+void dashboard_render_stats(ssd1306_t *display, const history_t *water, const history_t *rain) {
+    ssd1306_fill(display, false);
+    ssd1306_draw_string(display, "MIN/MED/MAX", 0, 0);
+    draw_stats_line(display, "Nivel", water, 16);
+    draw_stats_line(display, "Chuva", rain, 40);
+}
+
+uint16_t dashboard_percent(float value) {
+    if (value <= 0.0f) {
+        return 0;
+    }
+    if (value >= 100.0f) {
+        return 100;
+    }
+    return (uint16_t)value;
+}
@@ -0,0 +1,28 @@
+#ifndef DASHBOARD_H
+#define DASHBOARD_H
+
+#include "ssd1306.h"
+#include "sensor_data.h"
+#include "sparkline.h"
+#include "history.h"
+
+// Páginas livres do painel ocupadas pelos gráficos de histórico (abaixo de cada barra)
+#define DASHBOARD_WATER_GRAPH_PAGE 3
+#define DASHBOARD_RAIN_GRAPH_PAGE 5
+
+// Desenha o painel principal (tempo até o crítico, nível, chuva e status) no buffer
+// do display. Não envia nada pelo I2C: a transferência fica a cargo do chamador.
+void dashboard_render(ssd1306_t *display, const sensor_data_t *data, int ch_water, int ch_rain);
+
+// Desenha os gráficos rolantes de nível e chuva nas páginas livres do painel
+void dashboard_draw_history(ssd1306_t *display, const sparkline_t *water, const sparkline_t *rain);
+
+// Páginas auxiliares: gráficos de histórico em destaque e estatísticas do histórico
+void dashboard_render_history(ssd1306_t *display, const sparkline_t *water, const sparkline_t *rain,
+                              uint32_t period_ms);
+void dashboard_render_stats(ssd1306_t *display, const history_t *water, const history_t *rain);
+
+// Converte um valor de canal em porcentagem inteira limitada a 0-100
+uint16_t dashboard_percent(float value);
+
+#endif
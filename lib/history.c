@@ -0,0 +1,90 @@
+#include <string.h>
+#include "history.h"
+
+void history_init(history_t *history, uint32_t period_ms) {
+    memset(history, 0, sizeof(*history));
+    history->period_ms = period_ms;
+}
+
+// Retoma um histórico restaurado de outra execução: mantém as posições gravadas e
+// descarta o intervalo em acumulação, cujos instantes são do relógio anterior
+void history_resume(history_t *history) {
+    history->sum = 0.0f;
+    history->weight_ms = 0;
+    history->started = false;
+}
+
+// Acumula uma amostra; ao fechar o intervalo grava a média e devolve true
+bool history_add(history_t *history, float value, uint32_t now_ms) {
+    if (!history->started) {
+        history->window_start_ms = now_ms;
+        history->last_ms = now_ms;
+        history->last_value = value;
+        history->started = true;
+    }
+
+    // O valor anterior vigorou desde a amostra anterior até agora
+    uint32_t dt = now_ms - history->last_ms;
+    history->sum += history->last_value * dt;
+    history->weight_ms += dt;
+    history->last_ms = now_ms;
+    history->last_value = value;
+    if (now_ms - history->window_start_ms < history->period_ms) {
+        return false;
+    }
+
+    float mean = history->weight_ms ? history->sum / history->weight_ms : value;
+    if (mean < 0.0f) {
+        mean = 0.0f;
+    } else if (mean > 100.0f) {
+        mean = 100.0f;
+    }
+
+    // O valor é escrito antes de o contador avançar, então o leitor nunca vê uma posição vazia
+    history->values[history->count % HISTORY_LENGTH] = (uint8_t)(mean + 0.5f);
+    history->count++;
+
+    history->window_start_ms += history->period_ms;
+    if (now_ms - history->window_start_ms >= history->period_ms) {
+        // Lacuna maior que um intervalo (amostragem lenta ou tarefa atrasada): reinicia a janela agora
+        history->window_start_ms = now_ms;
+    }
+    history->sum = 0.0f;
+    history->weight_ms = 0;
+    return true;
+}
+
+// Valor da posição absoluta index (válido enquanto count - index <= HISTORY_LENGTH)
+uint8_t history_get(const history_t *history, uint32_t index) {
+    return history->values[index % HISTORY_LENGTH];
+}
+
+// Índice da posição mais antiga ainda disponível
+uint32_t history_oldest(const history_t *history) {
+    uint32_t count = history->count;
+    return count > HISTORY_LENGTH ? count - HISTORY_LENGTH : 0;
+}
+
+void history_stats(const history_t *history, history_stats_t *stats) {
+    uint32_t count = history->count;
+    uint32_t sum = 0;
+
+    stats->count = 0;
+    stats->min = 100;
+    stats->max = 0;
+    for (uint32_t i = history_oldest(history); i != count; i++) {
+        uint8_t value = history_get(history, i);
+        if (value < stats->min) {
+            stats->min = value;
+        }
+        if (value > stats->max) {
+            stats->max = value;
+        }
+        sum += value;
+        stats->count++;
+    }
+    if (stats->count == 0) {
+        stats->min = 0;
+    }
+    stats->mean = stats->count ? (float)sum / stats->count : 0.0f;
+}
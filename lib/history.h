@@ -0,0 +1,41 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Histórico de tamanho fixo: cada posição guarda a média (0-100%) de um intervalo de
+// period_ms, ponderada pelo tempo em que cada amostra vigorou. Assim o espaçamento
+// irregular da amostragem adaptativa não distorce a média (rajadas a 100 Hz não pesam
+// mais que uma amostra a 0,2 Hz). Um único produtor chama history_add;
+// os leitores acompanham o contador de posições (count) sem trava.
+#define HISTORY_LENGTH 128
+
+typedef struct {
+    uint8_t values[HISTORY_LENGTH];
+    volatile uint32_t count;   // Posições já escritas desde o início (índice = count % LENGTH)
+    uint32_t period_ms;        // Intervalo representado por cada posição
+    uint32_t window_start_ms;  // Início do intervalo em acumulação
+    float sum;                 // Soma de valor × duração (%·ms) no intervalo
+    uint32_t weight_ms;        // Duração acumulada no intervalo
+    uint32_t last_ms;          // Instante da amostra anterior
+    float last_value;          // Valor da amostra anterior (vigora até a próxima)
+    bool started;
+} history_t;
+
+// Resumo das posições disponíveis no histórico
+typedef struct {
+    uint32_t count;            // Posições consideradas
+    uint8_t min;
+    uint8_t max;
+    float mean;
+} history_stats_t;
+
+void history_init(history_t *history, uint32_t period_ms);
+void history_resume(history_t *history);
+bool history_add(history_t *history, float value, uint32_t now_ms);
+uint8_t history_get(const history_t *history, uint32_t index);
+uint32_t history_oldest(const history_t *history);
+void history_stats(const history_t *history, history_stats_t *stats);
+
+#endif
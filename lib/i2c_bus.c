@@ -0,0 +1,299 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "i2c_bus.h"
+#include "rt_monitor.h"
+#include "static_alloc.h"
+#include "supervisor.h"
+
+// Operações suportadas pelo gerenciador
+typedef enum {
+    I2C_OP_WRITE,
+    I2C_OP_READ,
+    I2C_OP_WRITE_READ,
+    I2C_OP_WRITE_CHUNKED
+} i2c_op_t;
+
+// Transação pendente; vive na pilha da tarefa chamadora até a conclusão
+typedef struct {
+    i2c_op_t op;
+    uint8_t address;
+    i2c_bus_priority_t priority;
+    const uint8_t *src;
+    size_t src_len;
+    uint8_t *dst;
+    size_t dst_len;
+    TaskHandle_t waiter;
+    UBaseType_t client_priority;   // Prioridade herdada pelo servidor durante a espera
+    uint32_t released_us;          // Liberação do ciclo do cliente (início da espera)
+    int result;
+} i2c_request_t;
+
+static i2c_inst_t *bus_i2c;
+static uint32_t bus_baudrate;          // Taxa pedida, reaplicada a cada troca de clk_sys
+static uint32_t bus_byte_us;           // Duração de um byte (9 bits) no barramento
+static TaskHandle_t bus_task;
+static UBaseType_t base_priority;      // Prioridade do servidor sem clientes à espera
+static uint8_t waiting[configMAX_PRIORITIES];  // Clientes à espera, por prioridade
+static QueueHandle_t queues[2];        // Indexadas por i2c_bus_priority_t
+static SemaphoreHandle_t transfer_lock;  // Mantido durante cada transferência no periférico
+static i2c_bus_stats_t stats;
+static uint8_t chunk_buffer[I2C_BUS_CHUNK_BYTES + 1];
+
+#if HYDRO_STATIC_ALLOCATION
+static uint8_t queue_storage[2][I2C_BUS_QUEUE_LENGTH * sizeof(i2c_request_t *)] HYDRO_ARENA;
+static StaticQueue_t queue_structs[2] HYDRO_ARENA;
+static StaticSemaphore_t transfer_lock_struct HYDRO_ARENA;
+#endif
+
+void i2c_bus_init(i2c_inst_t *i2c, uint32_t baudrate, uint8_t sda, uint8_t scl) {
+    uint32_t actual = i2c_init(i2c, baudrate);
+    gpio_set_function(sda, GPIO_FUNC_I2C);
+    gpio_set_function(scl, GPIO_FUNC_I2C);
+    gpio_pull_up(sda);
+    gpio_pull_up(scl);
+
+    bus_i2c = i2c;
+    bus_baudrate = baudrate;
+    bus_byte_us = 9000000 / actual + 1;
+    memset(&stats, 0, sizeof(stats));
+    for (int i = 0; i < 2; i++) {
+        queues[i] = static_alloc_queue(I2C_BUS_QUEUE_LENGTH, sizeof(i2c_request_t *),
+                                       STATIC_MEMORY(queue_storage[i]), STATIC_MEMORY(&queue_structs[i]));
+    }
+    transfer_lock = static_alloc_mutex(STATIC_MEMORY(&transfer_lock_struct));
+}
+
+// Registra a tarefa servidora antes do agendador; a prioridade de criação é a base
+void i2c_bus_attach(TaskHandle_t server) {
+    bus_task = server;
+    base_priority = uxTaskPriorityGet(server);
+}
+
+// O divisor de SCL é calculado sobre clk_sys; a troca de clock ocorre com o barramento
+// ocioso (i2c_bus_clock_guard)
+void i2c_bus_clock_changed(uint32_t sys_hz) {
+    (void)sys_hz;
+    uint32_t actual = i2c_set_baudrate(bus_i2c, bus_baudrate);
+    bus_byte_us = 9000000 / actual + 1;
+}
+
+// Limite de tempo proporcional ao tamanho da transferência
+static uint32_t timeout_for(size_t len) {
+    return I2C_BUS_TIMEOUT_US + (uint32_t)(len + 1) * bus_byte_us;
+}
+
+// A troca de clk_sys espera o fim da transferência em andamento e bloqueia a próxima.
+// O mutex empresta ao servidor a prioridade de quem troca o clock até o fim do bloco.
+void i2c_bus_clock_guard(bool enter) {
+    if (transfer_lock == NULL || xTaskGetSchedulerState() != taskSCHEDULER_RUNNING) {
+        return;
+    }
+    if (enter) {
+        xSemaphoreTake(transfer_lock, portMAX_DELAY);
+    } else {
+        xSemaphoreGive(transfer_lock);
+    }
+}
+
+// O servidor roda na prioridade do cliente mais prioritário à espera (em atendimento
+// ou na fila), ou na base sem clientes: o quadro do display corre na prioridade do
+// display, e uma leitura de sensor pedida no meio dele sobe o servidor até o fim do
+// bloco corrente. Chamada em seção crítica.
+static void inherit_priority(void) {
+    UBaseType_t priority = base_priority;
+
+    for (UBaseType_t p = configMAX_PRIORITIES - 1; p > base_priority; p--) {
+        if (waiting[p] > 0) {
+            priority = p;
+            break;
+        }
+    }
+    vTaskPrioritySet(bus_task, priority);
+}
+
+// Acorda o cliente e só então volta à prioridade dos que ainda esperam, para que ele
+// não fique atrás de tarefas intermediárias. A requisição vive na pilha do cliente e
+// não é mais tocada depois da notificação.
+static void complete(i2c_request_t *request, int result) {
+    UBaseType_t priority = request->client_priority;
+
+    request->result = result;
+    xTaskNotifyGive(request->waiter);
+    taskENTER_CRITICAL();
+    waiting[priority]--;
+    inherit_priority();
+    taskEXIT_CRITICAL();
+}
+
+static int execute(i2c_request_t *request);
+
+// Atende todas as transações de alta prioridade pendentes; devolve quantas foram atendidas
+static uint32_t serve_high(void) {
+    i2c_request_t *request;
+    uint32_t served = 0;
+
+    while (xQueueReceive(queues[I2C_BUS_PRIORITY_HIGH], &request, 0) == pdTRUE) {
+        complete(request, execute(request));
+        served++;
+    }
+    return served;
+}
+
+// Envia src[1..] em blocos, repetindo o byte de controle src[0] no início de cada um
+static int write_chunked(const i2c_request_t *request) {
+    size_t offset = 1;
+
+    chunk_buffer[0] = request->src[0];
+    while (offset < request->src_len) {
+        size_t n = request->src_len - offset;
+        if (n > I2C_BUS_CHUNK_BYTES) {
+            n = I2C_BUS_CHUNK_BYTES;
+        }
+        memcpy(&chunk_buffer[1], &request->src[offset], n);
+        xSemaphoreTake(transfer_lock, portMAX_DELAY);
+        int rc = i2c_write_timeout_us(bus_i2c, request->address, chunk_buffer, n + 1, false, timeout_for(n + 1));
+        xSemaphoreGive(transfer_lock);
+        if (rc < 0) {
+            return rc;
+        }
+        offset += n;
+        stats.chunks++;
+
+        // Ponto de preempção entre blocos
+        if (offset < request->src_len) {
+            stats.preemptions += serve_high();
+        }
+    }
+    return (int)request->src_len;
+}
+
+// Transações simples, feitas de uma vez com o periférico reservado
+static int transfer(const i2c_request_t *request) {
+    int rc;
+
+    xSemaphoreTake(transfer_lock, portMAX_DELAY);
+    switch (request->op) {
+        case I2C_OP_WRITE:
+            rc = i2c_write_timeout_us(bus_i2c, request->address, request->src, request->src_len, false,
+                                      timeout_for(request->src_len));
+            break;
+        case I2C_OP_READ:
+            rc = i2c_read_timeout_us(bus_i2c, request->address, request->dst, request->dst_len, false,
+                                     timeout_for(request->dst_len));
+            break;
+        case I2C_OP_WRITE_READ:
+            // Escrita do registrador sem STOP, seguida de leitura com START repetido
+            rc = i2c_write_timeout_us(bus_i2c, request->address, request->src, request->src_len, true,
+                                      timeout_for(request->src_len));
+            if (rc >= 0) {
+                rc = i2c_read_timeout_us(bus_i2c, request->address, request->dst, request->dst_len, false,
+                                         timeout_for(request->dst_len));
+            }
+            break;
+        default:
+            rc = PICO_ERROR_GENERIC;
+            break;
+    }
+    xSemaphoreGive(transfer_lock);
+    return rc;
+}
+
+static int execute(i2c_request_t *request) {
+    if (request->priority == I2C_BUS_PRIORITY_HIGH) {
+        uint32_t wait_us = time_us_32() - request->released_us;
+        if (wait_us > stats.max_high_wait_us) {
+            stats.max_high_wait_us = wait_us;
+        }
+    }
+
+    int rc = request->op == I2C_OP_WRITE_CHUNKED ? write_chunked(request) : transfer(request);
+    if (rc < 0) {
+        stats.errors++;
+    } else {
+        stats.transactions++;
+    }
+    return rc;
+}
+
+// Tarefa gerenciadora, criada na menor prioridade entre as clientes do barramento e
+// registrada com i2c_bus_attach; sobe conforme os clientes à espera
+void vI2CBusTask(void *params) {
+    i2c_request_t *request;
+
+    while (true) {
+        // Acorda também sem pedidos para sinalizar ao supervisor
+        supervisor_beat();
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(I2C_BUS_IDLE_WAKE_MS));
+
+        // Alta prioridade sempre primeiro; baixa prioridade uma transação por vez
+        do {
+            serve_high();
+            if (xQueueReceive(queues[I2C_BUS_PRIORITY_LOW], &request, 0) != pdTRUE) {
+                break;
+            }
+            complete(request, execute(request));
+        } while (true);
+    }
+}
+
+// Enfileira a transação e bloqueia até a tarefa gerenciadora concluí-la. Antes de
+// enfileirar, empresta ao servidor a prioridade da chamadora.
+static int submit(i2c_request_t *request) {
+    configASSERT(bus_task != NULL);
+
+    request->waiter = xTaskGetCurrentTaskHandle();
+    request->client_priority = uxTaskPriorityGet(NULL);
+    request->released_us = rt_monitor_release_us();
+    taskENTER_CRITICAL();
+    waiting[request->client_priority]++;
+    inherit_priority();
+    taskEXIT_CRITICAL();
+    xQueueSend(queues[request->priority], &request, portMAX_DELAY);
+    xTaskNotifyGive(bus_task);
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    return request->result;
+}
+
+int i2c_bus_write(uint8_t address, const uint8_t *src, size_t len, i2c_bus_priority_t priority) {
+    i2c_request_t request = { .op = I2C_OP_WRITE, .address = address, .priority = priority,
+                              .src = src, .src_len = len };
+    return submit(&request);
+}
+
+int i2c_bus_read(uint8_t address, uint8_t *dst, size_t len, i2c_bus_priority_t priority) {
+    i2c_request_t request = { .op = I2C_OP_READ, .address = address, .priority = priority,
+                              .dst = dst, .dst_len = len };
+    return submit(&request);
+}
+
+int i2c_bus_write_read(uint8_t address, const uint8_t *src, size_t src_len,
+                       uint8_t *dst, size_t dst_len, i2c_bus_priority_t priority) {
+    i2c_request_t request = { .op = I2C_OP_WRITE_READ, .address = address, .priority = priority,
+                              .src = src, .src_len = src_len, .dst = dst, .dst_len = dst_len };
+    return submit(&request);
+}
+
+int i2c_bus_write_chunked(uint8_t address, const uint8_t *src, size_t len, i2c_bus_priority_t priority) {
+    i2c_request_t request = { .op = I2C_OP_WRITE_CHUNKED, .address = address, .priority = priority,
+                              .src = src, .src_len = len };
+    return submit(&request);
+}
+
+// Comandos (byte de controle 0x80/0x00) seguem inteiros; o quadro (0x40) vai em blocos
+int i2c_bus_ssd1306_write(void *ctx, uint8_t address, const uint8_t *src, size_t len) {
+    (void)ctx;
+    if (len > I2C_BUS_CHUNK_BYTES + 1 && src[0] == 0x40) {
+        return i2c_bus_write_chunked(address, src, len, I2C_BUS_PRIORITY_LOW);
+    }
+    return i2c_bus_write(address, src, len, I2C_BUS_PRIORITY_LOW);
+}
+
+void i2c_bus_get_stats(i2c_bus_stats_t *out) {
+    taskENTER_CRITICAL();
+    *out = stats;
+    taskEXIT_CRITICAL();
+}
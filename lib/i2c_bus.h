@@ -0,0 +1,65 @@
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "hardware/i2c.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Gerenciador do barramento I2C compartilhado: uma única tarefa acessa o periférico e
+// atende as transações em duas filas de prioridade. A tarefa roda na prioridade do
+// cliente mais prioritário à espera, então o quadro do display corre na prioridade do
+// display e as demais tarefas o interrompem. Escritas longas são enviadas em blocos de
+// I2C_BUS_CHUNK_BYTES; entre um bloco e outro as transações de alta prioridade (leituras
+// de sensor) são atendidas. Contada da liberação do cliente, a espera de uma leitura de
+// sensor pedida durante um quadro fica em um bloco, (I2C_BUS_CHUNK_BYTES + 2) * 9 bits
+// ≈ 0,8 ms a 400 kHz, mais as tarefas de prioridade maior que a dele.
+#define I2C_BUS_CHUNK_BYTES 32
+#define I2C_BUS_QUEUE_LENGTH 4
+#define I2C_BUS_TIMEOUT_US 5000    // Limite por transação (dispositivo travado no barramento)
+#define I2C_BUS_IDLE_WAKE_MS 500   // Despertar periódico sem pedidos (sinal ao supervisor)
+
+typedef enum {
+    I2C_BUS_PRIORITY_HIGH,         // Leituras de sensor
+    I2C_BUS_PRIORITY_LOW           // Display e demais escritas longas
+} i2c_bus_priority_t;
+
+// Estatísticas do barramento
+typedef struct {
+    uint32_t transactions;         // Transações concluídas
+    uint32_t chunks;               // Blocos enviados por escritas fracionadas
+    uint32_t preemptions;          // Transações de alta prioridade atendidas entre blocos
+    uint32_t errors;               // Falhas (NACK ou tempo esgotado)
+    uint32_t max_high_wait_us;     // Maior espera de alta prioridade, desde a liberação do cliente
+} i2c_bus_stats_t;
+
+void i2c_bus_init(i2c_inst_t *i2c, uint32_t baudrate, uint8_t sda, uint8_t scl);
+void vI2CBusTask(void *params);
+
+// Registra a tarefa servidora (antes do agendador); a prioridade de criação é a base
+void i2c_bus_attach(TaskHandle_t server);
+
+// Ouvinte de power_register_listener: refaz o divisor de SCL para o novo clk_sys
+void i2c_bus_clock_changed(uint32_t sys_hz);
+
+// Guarda de power_set_guard: a troca de clk_sys espera o fim do bloco em andamento
+void i2c_bus_clock_guard(bool enter);
+
+// Chamadas bloqueantes para tarefas (não usar em ISR). Devolvem os bytes transferidos
+// ou um código de erro negativo do SDK. A tarefa chamadora é acordada por notificação.
+int i2c_bus_write(uint8_t address, const uint8_t *src, size_t len, i2c_bus_priority_t priority);
+int i2c_bus_read(uint8_t address, uint8_t *dst, size_t len, i2c_bus_priority_t priority);
+int i2c_bus_write_read(uint8_t address, const uint8_t *src, size_t src_len,
+                       uint8_t *dst, size_t dst_len, i2c_bus_priority_t priority);
+
+// Escrita fracionada: src[0] é o byte de controle, repetido no início de cada bloco
+int i2c_bus_write_chunked(uint8_t address, const uint8_t *src, size_t len, i2c_bus_priority_t priority);
+
+// Transporte para ssd1306_set_transport (comandos diretos, quadro em blocos)
+int i2c_bus_ssd1306_write(void *ctx, uint8_t address, const uint8_t *src, size_t len);
+
+void i2c_bus_get_stats(i2c_bus_stats_t *stats);
+
+#endif
@@ -0,0 +1,87 @@
+#include "instrumentation.h"
+
+#if HYDRO_INSTRUMENTATION
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "task.h"
+
+// Número máximo de tarefas acompanhadas (aplicação + Idle + Timer)
+#define INSTR_MAX_TASKS 12
+
+typedef struct {
+    const char *name;
+    QueueHandle_t queue;
+    UBaseType_t length;
+    UBaseType_t high_water;    // Maior ocupação observada após um envio
+} instr_queue_info_t;
+
+static instr_queue_info_t queues[INSTR_QUEUE_COUNT];
+static TaskStatus_t task_status[INSTR_MAX_TASKS];
+static uint32_t prev_runtime[INSTR_MAX_TASKS + 1];
+static uint32_t prev_total_runtime = 0;
+static uint32_t last_report_ms = 0;
+
+// Contador de tempo de execução: temporizador de 1 MHz do RP2040
+uint32_t instr_runtime_counter(void) {
+    return time_us_32();
+}
+
+void instr_register_queue(instr_queue_t id, const char *name, QueueHandle_t queue, UBaseType_t length) {
+    queues[id].name = name;
+    queues[id].queue = queue;
+    queues[id].length = length;
+    queues[id].high_water = 0;
+}
+
+// Registra a ocupação da fila logo após um envio bem-sucedido
+void instr_queue_sent(instr_queue_t id) {
+    UBaseType_t depth = uxQueueMessagesWaiting(queues[id].queue);
+    if (depth > queues[id].high_water) {
+        queues[id].high_water = depth;
+    }
+}
+
+// Emite o relatório periodicamente
+void instr_poll(uint32_t now_ms) {
+    if (now_ms - last_report_ms >= INSTR_REPORT_PERIOD_MS) {
+        last_report_ms = now_ms;
+        instr_report();
+    }
+}
+
+// Relatório: CPU por tarefa no último período, menor folga de pilha e ocupação das filas
+// Formato: INS;tarefa;nome;cpu_pct;pilha_livre_palavras / INS;fila;nome;atual;maximo;capacidade
+void instr_report(void) {
+    uint32_t total_runtime;
+    UBaseType_t count = uxTaskGetSystemState(task_status, INSTR_MAX_TASKS, &total_runtime);
+    uint32_t elapsed = total_runtime - prev_total_runtime;
+    prev_total_runtime = total_runtime;
+
+    for (UBaseType_t i = 0; i < count; i++) {
+        const TaskStatus_t *status = &task_status[i];
+        UBaseType_t number = status->xTaskNumber <= INSTR_MAX_TASKS ? status->xTaskNumber : 0;
+        uint32_t delta = status->ulRunTimeCounter - prev_runtime[number];
+        prev_runtime[number] = status->ulRunTimeCounter;
+
+        float cpu = elapsed > 0 ? delta * 100.0f / elapsed : 0.0f;
+        printf("INS;tarefa;%s;%.1f;%lu\n", status->pcTaskName, cpu,
+               (unsigned long)status->usStackHighWaterMark);
+    }
+
+    for (int i = 0; i < INSTR_QUEUE_COUNT; i++) {
+        if (queues[i].queue != NULL) {
+            printf("INS;fila;%s;%lu;%lu;%lu\n", queues[i].name,
+                   (unsigned long)uxQueueMessagesWaiting(queues[i].queue),
+                   (unsigned long)queues[i].high_water, (unsigned long)queues[i].length);
+        }
+    }
+}
+
+// Estouro de pilha detectado pelo kernel (configCHECK_FOR_STACK_OVERFLOW)
+void vApplicationStackOverflowHook(TaskHandle_t task, char *name) {
+    (void)task;
+    panic("Estouro de pilha: %s", name);
+}
+
+#endif
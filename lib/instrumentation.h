@@ -0,0 +1,34 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include "FreeRTOS.h"
+#include "queue.h"
+
+// Instrumentação de CPU, pilhas e filas (opção HYDRO_INSTRUMENTATION do CMake)
+#ifndef HYDRO_INSTRUMENTATION
+#define HYDRO_INSTRUMENTATION 0
+#endif
+
+// Intervalo entre relatórios de instrumentação
+#define INSTR_REPORT_PERIOD_MS 5000
+
+// Filas monitoradas
+typedef enum {
+    INSTR_QUEUE_SENSOR,
+    INSTR_QUEUE_COUNT
+} instr_queue_t;
+
+#if HYDRO_INSTRUMENTATION
+void instr_register_queue(instr_queue_t id, const char *name, QueueHandle_t queue, UBaseType_t length);
+void instr_queue_sent(instr_queue_t id);
+void instr_poll(uint32_t now_ms);
+void instr_report(void);
+#else
+// Sem instrumentação as chamadas desaparecem na compilação
+#define instr_register_queue(id, name, queue, length) ((void)0)
+#define instr_queue_sent(id) ((void)0)
+#define instr_poll(now_ms) ((void)0)
+#define instr_report() ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,61 @@
+#include "latency_hist.h"
+
+void latency_hist_reset(latency_hist_t *hist) {
+    for (int i = 0; i < LATENCY_HIST_BUCKETS; i++) {
+        hist->counts[i] = 0;
+    }
+    hist->total = 0;
+    hist->min_us = UINT32_MAX;
+    hist->max_us = 0;
+    hist->sum_us = 0;
+}
+
+// Registra uma medida em O(1): a faixa é a posição do bit mais significativo
+void latency_hist_record(latency_hist_t *hist, uint32_t elapsed_us) {
+    int bucket = 31 - __builtin_clz(elapsed_us | 1u);
+    if (bucket >= LATENCY_HIST_BUCKETS) {
+        bucket = LATENCY_HIST_BUCKETS - 1;
+    }
+
+    hist->counts[bucket]++;
+    hist->total++;
+    hist->sum_us += elapsed_us;
+    if (elapsed_us < hist->min_us) {
+        hist->min_us = elapsed_us;
+    }
+    if (elapsed_us > hist->max_us) {
+        hist->max_us = elapsed_us;
+    }
+}
+
+// Limite superior (exclusivo) da faixa, em µs
+uint32_t latency_hist_bucket_limit(int bucket) {
+    return 2u << bucket;
+}
+
+// Percentil (0-100) estimado pelo limite superior da faixa que o contém,
+// limitado ao máximo observado; 0 se não houver medidas
+uint32_t latency_hist_percentile(const latency_hist_t *hist, float percentile) {
+    if (hist->total == 0) {
+        return 0;
+    }
+
+    uint32_t target = (uint32_t)(hist->total * percentile / 100.0f + 0.5f);
+    if (target == 0) {
+        target = 1;
+    }
+
+    uint32_t seen = 0;
+    for (int i = 0; i < LATENCY_HIST_BUCKETS; i++) {
+        seen += hist->counts[i];
+        if (seen >= target) {
+            uint32_t limit = latency_hist_bucket_limit(i);
+            return limit < hist->max_us ? limit : hist->max_us;
+        }
+    }
+    return hist->max_us;
+}
+
+uint32_t latency_hist_mean(const latency_hist_t *hist) {
+    return hist->total > 0 ? (uint32_t)(hist->sum_us / hist->total) : 0;
+}
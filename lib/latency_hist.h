@@ -0,0 +1,24 @@
+#ifndef LATENCY_HIST_H
+#define LATENCY_HIST_H
+
+#include <stdint.h>
+
+// Histograma de latência com faixas logarítmicas: a faixa k cobre [2^k, 2^(k+1)) µs
+// (a faixa 0 inclui 0 µs e a última acumula tudo acima de 2^(N-1) µs)
+#define LATENCY_HIST_BUCKETS 24
+
+typedef struct {
+    uint32_t counts[LATENCY_HIST_BUCKETS];
+    uint32_t total;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t sum_us;
+} latency_hist_t;
+
+void latency_hist_reset(latency_hist_t *hist);
+void latency_hist_record(latency_hist_t *hist, uint32_t elapsed_us);
+uint32_t latency_hist_percentile(const latency_hist_t *hist, float percentile);
+uint32_t latency_hist_mean(const latency_hist_t *hist);
+uint32_t latency_hist_bucket_limit(int bucket);
+
+#endif
@@ -0,0 +1,71 @@
+#include "pico/stdlib.h"
+#include "mailbox.h"
+
+void mailbox_init(mailbox_t *mailbox, const char *name) {
+    mailbox->name = name;
+    mailbox->slot = SAMPLE_REF_NONE;
+    mailbox->events = 0;
+    mailbox->posted_us = 0;
+    mailbox->stats = (mailbox_stats_t){ 0 };
+    mailbox->signal = static_alloc_queue(1, sizeof(uint8_t), STATIC_MEMORY(mailbox->signal_storage),
+                                         STATIC_MEMORY(&mailbox->signal_struct));
+}
+
+// Entrega uma referência (a caixa assume a referência do chamador)
+void mailbox_post(mailbox_t *mailbox, sample_ref_t ref, uint32_t events) {
+    static const uint8_t doorbell = 1;
+
+    taskENTER_CRITICAL();
+    sample_ref_t replaced = mailbox->slot;
+    mailbox->slot = ref;
+    mailbox->events |= events;
+    mailbox->posted_us = time_us_32();
+    mailbox->stats.posts++;
+    if (replaced != SAMPLE_REF_NONE) {
+        mailbox->stats.overwrites++;
+    }
+    taskEXIT_CRITICAL();
+
+    if (replaced != SAMPLE_REF_NONE) {
+        sample_pool_release(replaced);
+    }
+    xQueueOverwrite(mailbox->signal, &doorbell);
+}
+
+// Aguarda até timeout por uma amostra; devolve SAMPLE_REF_NONE se nada chegou.
+// A referência devolvida passa a ser do consumidor, que deve liberá-la.
+sample_ref_t mailbox_take(mailbox_t *mailbox, uint32_t *events, TickType_t timeout) {
+    uint8_t doorbell;
+
+    if (xQueueReceive(mailbox->signal, &doorbell, timeout) != pdTRUE) {
+        if (events != NULL) {
+            *events = 0;
+        }
+        return SAMPLE_REF_NONE;
+    }
+
+    taskENTER_CRITICAL();
+    sample_ref_t ref = mailbox->slot;
+    uint32_t taken_events = mailbox->events;
+    mailbox->slot = SAMPLE_REF_NONE;
+    mailbox->events = 0;
+    if (ref != SAMPLE_REF_NONE) {
+        uint32_t stale_us = time_us_32() - mailbox->posted_us;
+        if (stale_us > mailbox->stats.max_stale_us) {
+            mailbox->stats.max_stale_us = stale_us;
+        }
+        mailbox->stats.takes++;
+    }
+    taskEXIT_CRITICAL();
+
+    if (events != NULL) {
+        *events = taken_events;
+    }
+    return ref;
+}
+
+void mailbox_get_stats(const mailbox_t *mailbox, mailbox_stats_t *stats) {
+    taskENTER_CRITICAL();
+    *stats = mailbox->stats;
+    taskEXIT_CRITICAL();
+}
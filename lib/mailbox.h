@@ -0,0 +1,39 @@
+#ifndef MAILBOX_H
+#define MAILBOX_H
+
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "sample_pool.h"
+#include "static_alloc.h"
+
+// Caixa de "último valor": guarda uma única referência do pool para um consumidor.
+// Um novo envio substitui a amostra ainda não lida (liberando a anterior), então o
+// consumidor sempre recebe o estado mais recente e o produtor nunca bloqueia. Os bits
+// de evento enviados com cada amostra se acumulam até a leitura, para que um evento
+// pontual (troca de modo, disparo de som) não se perca na substituição.
+typedef struct {
+    uint32_t posts;            // Amostras entregues à caixa
+    uint32_t overwrites;       // Amostras substituídas antes da leitura (descartadas)
+    uint32_t takes;            // Amostras lidas pelo consumidor
+    uint32_t max_stale_us;     // Maior espera entre o envio e a leitura
+} mailbox_stats_t;
+
+typedef struct {
+    const char *name;
+    QueueHandle_t signal;      // Fila de 1 posição usada apenas para acordar o consumidor
+    sample_ref_t slot;
+    uint32_t events;
+    uint32_t posted_us;
+    mailbox_stats_t stats;
+#if HYDRO_STATIC_ALLOCATION
+    uint8_t signal_storage[1];
+    StaticQueue_t signal_struct;
+#endif
+} mailbox_t;
+
+void mailbox_init(mailbox_t *mailbox, const char *name);
+void mailbox_post(mailbox_t *mailbox, sample_ref_t ref, uint32_t events);
+sample_ref_t mailbox_take(mailbox_t *mailbox, uint32_t *events, TickType_t timeout);
+void mailbox_get_stats(const mailbox_t *mailbox, mailbox_stats_t *stats);
+
+#endif
@@ -0,0 +1,196 @@
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "hardware/vreg.h"
+#include "hardware/structs/systick.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "power.h"
+
+// Pontos de operação: frequências com divisores exatos do PLL (VCO de 1440/1500 MHz)
+typedef struct {
+    uint32_t khz;
+    enum vreg_voltage vreg;
+    uint16_t mv;
+} power_step_t;
+
+static const power_step_t steps[POWER_LEVEL_COUNT] = {
+    [POWER_LEVEL_LOW] = { 48000, VREG_VOLTAGE_0_95, 950 },
+    [POWER_LEVEL_MID] = { 96000, VREG_VOLTAGE_1_05, 1050 },
+    [POWER_LEVEL_FULL] = { 125000, VREG_VOLTAGE_1_10, 1100 },
+};
+
+static power_clock_listener_t listeners[POWER_MAX_LISTENERS];
+static uint8_t listener_count = 0;
+static power_guard_t guard;
+static power_level_stats_t stats[POWER_LEVEL_COUNT];
+static power_level_t current = POWER_LEVEL_FULL;
+static uint64_t level_since_us;
+static bool manual = false;
+static bool down_pending = false;
+static uint32_t down_since_ms;
+
+// O sistema parte no clock padrão do SDK (125 MHz, 1,10 V)
+void power_init(void) {
+    for (int i = 0; i < POWER_LEVEL_COUNT; i++) {
+        stats[i] = (power_level_stats_t){ 0 };
+    }
+    current = POWER_LEVEL_FULL;
+    level_since_us = time_us_64();
+    manual = false;
+    down_pending = false;
+}
+
+bool power_register_listener(power_clock_listener_t listener) {
+    if (listener_count >= POWER_MAX_LISTENERS) {
+        return false;
+    }
+    listeners[listener_count++] = listener;
+    return true;
+}
+
+void power_set_guard(power_guard_t function) {
+    guard = function;
+}
+
+// O tick do FreeRTOS vem do SysTick no clock do processador: recarga refeita para 1 kHz
+static void reload_systick(uint32_t sys_hz) {
+    systick_hw->rvr = sys_hz / configTICK_RATE_HZ - 1;
+    systick_hw->cvr = 0;
+}
+
+// A troca roda na tarefa de processamento. A guarda (barramento I2C) espera o fim da
+// transferência em andamento, então os periféricos trocam de divisor ociosos.
+bool power_set_level(power_level_t level) {
+    if (level >= POWER_LEVEL_COUNT) {
+        return false;
+    }
+    if (level == current) {
+        return true;
+    }
+
+    const power_step_t *step = &steps[level];
+    bool raising = step->khz > steps[current].khz;
+    uint32_t start_us = time_us_32();
+
+    // Subida: tensão antes do clock; descida: clock antes da tensão
+    if (raising) {
+        vreg_set_voltage(step->vreg);
+        busy_wait_us(POWER_VREG_SETTLE_US);
+    }
+
+    if (guard != NULL) {
+        guard(true);
+    }
+    taskENTER_CRITICAL();
+    bool ok = set_sys_clock_khz(step->khz, false);
+    if (ok) {
+        uint32_t sys_hz = clock_get_hz(clk_sys);
+        reload_systick(sys_hz);
+        for (uint8_t i = 0; i < listener_count; i++) {
+            listeners[i](sys_hz);
+        }
+    }
+    taskEXIT_CRITICAL();
+    if (guard != NULL) {
+        guard(false);
+    }
+
+    if (!ok) {
+        return false;
+    }
+    if (!raising) {
+        vreg_set_voltage(step->vreg);
+    }
+
+    uint32_t elapsed_us = time_us_32() - start_us;
+    uint64_t now_us = time_us_64();
+    taskENTER_CRITICAL();
+    stats[current].residency_us += now_us - level_since_us;
+    level_since_us = now_us;
+    current = level;
+    stats[level].entries++;
+    stats[level].last_switch_us = elapsed_us;
+    if (elapsed_us > stats[level].max_switch_us) {
+        stats[level].max_switch_us = elapsed_us;
+    }
+    taskEXIT_CRITICAL();
+    return true;
+}
+
+power_level_t power_get_level(void) {
+    return current;
+}
+
+bool power_request(power_level_t level, uint32_t now_ms) {
+    if (manual || level == current) {
+        down_pending = false;
+        return false;
+    }
+    if (level > current) {
+        down_pending = false;
+        return power_set_level(level);
+    }
+
+    // Descida só depois de o pedido se manter por POWER_DOWN_HOLD_MS
+    if (!down_pending) {
+        down_pending = true;
+        down_since_ms = now_ms;
+        return false;
+    }
+    if (now_ms - down_since_ms < POWER_DOWN_HOLD_MS) {
+        return false;
+    }
+    down_pending = false;
+    return power_set_level(level);
+}
+
+void power_set_manual(bool enable) {
+    manual = enable;
+    down_pending = false;
+}
+
+bool power_is_manual(void) {
+    return manual;
+}
+
+uint32_t power_level_khz(power_level_t level) {
+    return level < POWER_LEVEL_COUNT ? steps[level].khz : 0;
+}
+
+uint32_t power_level_mv(power_level_t level) {
+    return level < POWER_LEVEL_COUNT ? steps[level].mv : 0;
+}
+
+void power_get_stats(power_level_t level, power_level_stats_t *out) {
+    taskENTER_CRITICAL();
+    *out = stats[level];
+    if (level == current) {
+        out->residency_us += time_us_64() - level_since_us;
+    }
+    taskEXIT_CRITICAL();
+}
+
+void power_set_idle_ma(power_level_t level, float ma) {
+    if (level < POWER_LEVEL_COUNT) {
+        stats[level].idle_ma = ma;
+    }
+}
+
+float power_estimated_ma(void) {
+    power_level_stats_t level_stats;
+    double charge = 0.0;
+    uint64_t total_us = 0;
+
+    for (int i = 0; i < POWER_LEVEL_COUNT; i++) {
+        power_get_stats((power_level_t)i, &level_stats);
+        if (level_stats.residency_us == 0) {
+            continue;
+        }
+        if (level_stats.idle_ma <= 0.0f) {
+            return 0.0f;
+        }
+        charge += (double)level_stats.idle_ma * (double)level_stats.residency_us;
+        total_us += level_stats.residency_us;
+    }
+    return total_us > 0 ? (float)(charge / (double)total_us) : 0.0f;
+}
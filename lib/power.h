@@ -0,0 +1,63 @@
+#ifndef POWER_H
+#define POWER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Escalonamento dinâmico de clk_sys e da tensão do núcleo. Em modo NORMAL o sistema
+// roda em clock baixo; na escalada volta imediatamente ao clock máximo. Periféricos
+// que dependem de clk_sys (PWM, PIO, I2C, UART via clk_peri e o SysTick) são
+// reconfigurados pelos ouvintes registrados a cada troca.
+typedef enum {
+    POWER_LEVEL_LOW,           // 48 MHz, 0,95 V: NORMAL sem tendência
+    POWER_LEVEL_MID,           // 96 MHz, 1,05 V: NORMAL com amostragem acelerada
+    POWER_LEVEL_FULL,          // 125 MHz, 1,10 V: pré-alerta e modos de alerta
+    POWER_LEVEL_COUNT
+} power_level_t;
+
+#define POWER_MAX_LISTENERS 8
+#define POWER_VREG_SETTLE_US 200       // Estabilização do regulador antes de subir o clock
+#define POWER_DOWN_HOLD_MS 10000       // Tempo pedindo um nível menor antes de descer
+
+// Chamado dentro da seção crítica da troca, com o novo clk_sys em Hz: deve ser curto
+// e não pode bloquear (apenas reescrever divisores e registradores)
+typedef void (*power_clock_listener_t)(uint32_t sys_hz);
+
+// Chamada fora da seção crítica, antes (enter = true) e depois da troca; pode bloquear
+// até o periférico ficar ocioso. Só é chamada quando o nível muda de fato.
+typedef void (*power_guard_t)(bool enter);
+
+// Estatísticas por nível
+typedef struct {
+    uint32_t entries;          // Trocas para este nível
+    uint32_t last_switch_us;   // Duração da última troca (tensão, PLL e ouvintes)
+    uint32_t max_switch_us;    // Maior duração de troca
+    uint64_t residency_us;     // Tempo acumulado no nível
+    float idle_ma;             // Corrente em repouso medida externamente (0 = não calibrado)
+} power_level_stats_t;
+
+void power_init(void);
+bool power_register_listener(power_clock_listener_t listener);
+void power_set_guard(power_guard_t guard);
+
+// Troca imediata de nível; devolve false se o PLL não atinge a frequência
+bool power_set_level(power_level_t level);
+power_level_t power_get_level(void);
+
+// Pedido da política automática: sobe na hora, desce após POWER_DOWN_HOLD_MS.
+// Devolve true quando o nível mudou. Ignorado no modo manual.
+bool power_request(power_level_t level, uint32_t now_ms);
+void power_set_manual(bool manual);
+bool power_is_manual(void);
+
+uint32_t power_level_khz(power_level_t level);
+uint32_t power_level_mv(power_level_t level);
+void power_get_stats(power_level_t level, power_level_stats_t *stats);
+
+// Calibração: corrente medida com um amperímetro com o sistema fixo no nível
+void power_set_idle_ma(power_level_t level, float ma);
+
+// Corrente média estimada pelo tempo em cada nível (0 se algum nível visitado não foi calibrado)
+float power_estimated_ma(void);
+
+#endif
@@ -0,0 +1,60 @@
+#include "prediction.h"
+
+// Tendência mínima considerada (%/s); abaixo disso o nível é tratado como estável
+#define PREDICTION_MIN_SLOPE 0.001f
+
+// Horizonte máximo reportado (s), evita estimativas absurdas com tendências ínfimas
+#define PREDICTION_MAX_SECONDS 86400
+
+void prediction_init(prediction_t *p, float tau_level_s, float tau_slope_s) {
+    p->level = 0.0f;
+    p->slope = 0.0f;
+    p->tau_level = tau_level_s;
+    p->tau_slope = tau_slope_s;
+    p->primed = false;
+}
+
+void prediction_update(prediction_t *p, float sample, float dt_s) {
+    if (!p->primed) {
+        p->level = sample;
+        p->slope = 0.0f;
+        p->primed = true;
+        return;
+    }
+    if (dt_s <= 0.0f) {
+        return;
+    }
+
+    // Ganhos derivados do intervalo real entre amostras (dt / (tau + dt))
+    float alpha = dt_s / (p->tau_level + dt_s);
+    float beta = dt_s / (p->tau_slope + dt_s);
+
+    // Projeta o nível anterior até o instante atual e corrige com a nova amostra
+    float predicted = p->level + p->slope * dt_s;
+    float level = predicted + alpha * (sample - predicted);
+
+    // Atualiza a tendência com a variação observada do nível suavizado
+    float observed_slope = (level - p->level) / dt_s;
+    p->slope += beta * (observed_slope - p->slope);
+    p->level = level;
+}
+
+// Retorna os segundos estimados até o nível alvo, 0 se já foi atingido,
+// ou PREDICTION_NONE quando a tendência não aponta para o alvo
+int32_t prediction_time_to(const prediction_t *p, float target) {
+    if (!p->primed) {
+        return PREDICTION_NONE;
+    }
+    if (p->level >= target) {
+        return 0;
+    }
+    if (p->slope < PREDICTION_MIN_SLOPE) {
+        return PREDICTION_NONE;
+    }
+
+    float seconds = (target - p->level) / p->slope;
+    if (seconds > PREDICTION_MAX_SECONDS) {
+        return PREDICTION_NONE;
+    }
+    return (int32_t)seconds;
+}
@@ -0,0 +1,24 @@
+#ifndef PREDICTION_H
+#define PREDICTION_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Estimador incremental de nível e tendência (suavização exponencial dupla de Holt).
+// Cada atualização custa O(1) em tempo e memória e aceita intervalos irregulares.
+typedef struct {
+    float level;        // Nível suavizado (%)
+    float slope;        // Tendência suavizada (%/s)
+    float tau_level;    // Constante de tempo do nível (s)
+    float tau_slope;    // Constante de tempo da tendência (s)
+    bool primed;        // Já recebeu a primeira amostra
+} prediction_t;
+
+// Valor retornado quando não há previsão (nível estável ou em queda)
+#define PREDICTION_NONE -1
+
+void prediction_init(prediction_t *p, float tau_level_s, float tau_slope_s);
+void prediction_update(prediction_t *p, float sample, float dt_s);
+int32_t prediction_time_to(const prediction_t *p, float target);
+
+#endif
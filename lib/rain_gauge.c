@@ -0,0 +1,119 @@
+#include "rain_gauge.h"
+#include "hardware/dma.h"
+#include "rain_gauge.pio.h"
+
+// Anel de carimbos (em ticks da PIO) escrito pelo DMA sem intervenção da CPU
+static uint32_t tip_ring[RAIN_GAUGE_RING_SIZE] __attribute__((aligned(1u << RAIN_GAUGE_RING_BITS)));
+
+// Contagem inicial do DMA; o número de carimbos produzidos é o quanto ela já decresceu
+#define RAIN_GAUGE_DMA_COUNT 0xFFFFFFFFu
+
+// Margem de entradas mais antigas que não são lidas, pois o DMA pode estar sobrescrevendo
+#define RAIN_GAUGE_RING_GUARD 8
+
+// Inicializa a máquina de estados de captura e o canal de DMA que drena a FIFO RX
+bool rain_gauge_init(rain_gauge_t *gauge, PIO pio, uint pin, float mm_per_tip) {
+    if (!pio_can_add_program(pio, &rain_gauge_program)) {
+        return false;
+    }
+    int sm = pio_claim_unused_sm(pio, false);
+    int dma_chan = dma_claim_unused_channel(false);
+    if (sm < 0 || dma_chan < 0) {
+        // Devolve o recurso que chegou a ser reservado
+        if (sm >= 0) {
+            pio_sm_unclaim(pio, (uint)sm);
+        }
+        if (dma_chan >= 0) {
+            dma_channel_unclaim((uint)dma_chan);
+        }
+        return false;
+    }
+
+    gauge->pio = pio;
+    gauge->sm = (uint)sm;
+    gauge->pin = pin;
+    gauge->dma_chan = dma_chan;
+    gauge->mm_per_tip = mm_per_tip;
+    gauge->consumed = 0;
+    gauge->total_tips = 0;
+    gauge->lost_tips = 0;
+
+    // DMA: FIFO RX -> anel, com escrita circular e ritmo ditado pela PIO
+    dma_channel_config c = dma_channel_get_default_config(dma_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, RAIN_GAUGE_RING_BITS);
+    channel_config_set_dreq(&c, pio_get_dreq(pio, sm, false));
+    dma_channel_configure(dma_chan, &c, tip_ring, &pio->rxf[sm], RAIN_GAUGE_DMA_COUNT, true);
+
+    uint offset = pio_add_program(pio, &rain_gauge_program);
+    rain_gauge_program_init(pio, sm, offset, pin, RAIN_GAUGE_TICK_US);
+    gauge->start_us = time_us_64();
+    return true;
+}
+
+// Recalcula o divisor da PIO para manter o tick após mudança de clk_sys
+void rain_gauge_set_clkdiv(rain_gauge_t *gauge) {
+    pio_sm_set_clkdiv(gauge->pio, gauge->sm, rain_gauge_program_clkdiv(RAIN_GAUGE_TICK_US));
+}
+
+// Contabiliza as basculadas novas e retorna quantas chegaram desde a última chamada
+uint32_t rain_gauge_poll(rain_gauge_t *gauge) {
+    uint32_t produced = RAIN_GAUGE_DMA_COUNT - dma_channel_hw_addr(gauge->dma_chan)->transfer_count;
+    uint32_t pending = produced - gauge->consumed;
+
+    // Rajada maior que o anel: as entradas mais antigas foram sobrescritas
+    if (pending > RAIN_GAUGE_RING_SIZE) {
+        gauge->lost_tips += pending - RAIN_GAUGE_RING_SIZE;
+    }
+
+    gauge->consumed = produced;
+    gauge->total_tips += pending;
+    return pending;
+}
+
+// Intensidade (mm/h) a partir das basculadas dentro da janela recente
+float rain_gauge_intensity(rain_gauge_t *gauge) {
+    rain_gauge_poll(gauge);
+
+    uint32_t now_ticks = (uint32_t)((time_us_64() - gauge->start_us) / RAIN_GAUGE_TICK_US);
+    uint32_t window_ticks = RAIN_GAUGE_WINDOW_S * (1000000u / RAIN_GAUGE_TICK_US);
+    uint32_t available = gauge->consumed;
+    bool ring_limited = available > RAIN_GAUGE_RING_SIZE - RAIN_GAUGE_RING_GUARD;
+    if (ring_limited) {
+        available = RAIN_GAUGE_RING_SIZE - RAIN_GAUGE_RING_GUARD;
+    }
+
+    // Percorre do carimbo mais novo para o mais antigo até sair da janela
+    uint32_t count = 0;
+    uint32_t oldest = now_ticks;
+    for (uint32_t i = 0; i < available; i++) {
+        uint32_t stamp = tip_ring[(gauge->consumed - 1 - i) % RAIN_GAUGE_RING_SIZE];
+        if (now_ticks - stamp > window_ticks) {
+            break;
+        }
+        oldest = stamp;
+        count++;
+    }
+
+    if (count == 0) {
+        return 0.0f;
+    }
+
+    // Janela inteira coberta pelos carimbos disponíveis: taxa média na janela;
+    // caso contrário (chuva muito intensa), taxa sobre o intervalo efetivamente coberto
+    float span_s = (float)RAIN_GAUGE_WINDOW_S;
+    if (ring_limited && count == available) {
+        span_s = (now_ticks - oldest) * (RAIN_GAUGE_TICK_US / 1000000.0f);
+        if (span_s < 1.0f) {
+            span_s = 1.0f;
+        }
+    }
+    return count * gauge->mm_per_tip * 3600.0f / span_s;
+}
+
+// Driver de canal de sensor: intensidade de chuva em mm/h
+float rain_gauge_read_intensity(void *ctx) {
+    return rain_gauge_intensity((rain_gauge_t *)ctx);
+}
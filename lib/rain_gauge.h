@@ -0,0 +1,36 @@
+#ifndef RAIN_GAUGE_H
+#define RAIN_GAUGE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "hardware/pio.h"
+
+// Duração de um tick do carimbo de tempo da PIO (µs); debounce = 32 ticks (8 ms)
+#define RAIN_GAUGE_TICK_US 250
+
+// Anel de carimbos preenchido por DMA (potência de 2, alinhado ao tamanho)
+#define RAIN_GAUGE_RING_BITS 8
+#define RAIN_GAUGE_RING_SIZE ((1u << RAIN_GAUGE_RING_BITS) / sizeof(uint32_t))
+
+// Janela usada no cálculo da intensidade (s)
+#define RAIN_GAUGE_WINDOW_S 600
+
+typedef struct {
+    PIO pio;
+    uint sm;
+    uint pin;
+    int dma_chan;
+    float mm_per_tip;          // Precipitação por basculada (mm)
+    uint64_t start_us;         // Instante em que a contagem de ticks começou
+    uint32_t consumed;         // Basculadas já contabilizadas pelo consumidor
+    uint32_t total_tips;       // Total de basculadas desde o início
+    uint32_t lost_tips;        // Carimbos sobrescritos antes de serem lidos
+} rain_gauge_t;
+
+bool rain_gauge_init(rain_gauge_t *gauge, PIO pio, uint pin, float mm_per_tip);
+void rain_gauge_set_clkdiv(rain_gauge_t *gauge);
+uint32_t rain_gauge_poll(rain_gauge_t *gauge);
+float rain_gauge_intensity(rain_gauge_t *gauge);
+float rain_gauge_read_intensity(void *ctx);
+
+#endif
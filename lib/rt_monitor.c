@@ -0,0 +1,210 @@
+#include "pico/stdlib.h"
+#include "rt_monitor.h"
+
+typedef struct {
+    TaskHandle_t task;
+    const char *name;
+    uint32_t period_ms;
+    uint32_t deadline_ms;
+    TickType_t release;        // Liberação corrente (base do vTaskDelayUntil)
+    bool released;             // release já foi fixada pela primeira espera
+    bool open;                 // Ciclo iniciado e ainda não concluído
+    bool paced;                // prev_start_us vale para medir o jitter
+    uint32_t start_us;
+    uint32_t release_us;       // Liberação estimada do ciclo aberto
+    uint32_t prev_start_us;
+    uint32_t cycles;
+    uint32_t misses;
+    uint32_t skipped;
+    uint32_t max_response_us;
+    uint32_t max_jitter_us;
+} monitored_task_t;
+
+static monitored_task_t monitored[RT_MONITOR_MAX_TASKS];
+static uint8_t monitored_count = 0;
+
+bool rt_monitor_watch(TaskHandle_t task, const char *name, uint32_t period_ms, uint32_t deadline_ms) {
+    if (monitored_count >= RT_MONITOR_MAX_TASKS || task == NULL || period_ms == 0 || deadline_ms == 0) {
+        return false;
+    }
+    monitored[monitored_count] = (monitored_task_t){
+        .task = task,
+        .name = name,
+        .period_ms = period_ms,
+        .deadline_ms = deadline_ms,
+    };
+    monitored_count++;
+    return true;
+}
+
+static monitored_task_t *self_entry(void) {
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    for (uint8_t i = 0; i < monitored_count; i++) {
+        if (monitored[i].task == self) {
+            return &monitored[i];
+        }
+    }
+    return NULL;
+}
+
+static void cycle_begin(monitored_task_t *entry) {
+    entry->start_us = time_us_32();
+    entry->release_us = entry->start_us;
+    entry->open = true;
+}
+
+static void cycle_end(monitored_task_t *entry) {
+    if (!entry->open) {
+        return;
+    }
+    uint32_t response = time_us_32() - entry->start_us;
+    entry->open = false;
+    entry->cycles++;
+    if (response > entry->max_response_us) {
+        entry->max_response_us = response;
+    }
+    if (response > entry->deadline_ms * 1000u) {
+        entry->misses++;
+    }
+}
+
+// Início de ciclo com medida do jitter em relação à liberação anterior
+static void paced_begin(monitored_task_t *entry, TickType_t increment) {
+    cycle_begin(entry);
+    // A liberação foi no tick entry->release; o atraso até o início conta em ticks inteiros
+    entry->release_us -= (uint32_t)(xTaskGetTickCount() - entry->release) * portTICK_PERIOD_MS * 1000u;
+    uint32_t expected_us = (uint32_t)increment * portTICK_PERIOD_MS * 1000u;
+    if (entry->paced) {
+        uint32_t interval = entry->start_us - entry->prev_start_us;
+        uint32_t jitter = interval > expected_us ? interval - expected_us : expected_us - interval;
+        if (jitter > entry->max_jitter_us) {
+            entry->max_jitter_us = jitter;
+        }
+    }
+    entry->prev_start_us = entry->start_us;
+    entry->paced = true;
+}
+
+static TickType_t period_ticks(const monitored_task_t *entry) {
+    return pdMS_TO_TICKS(entry->period_ms) > 0 ? pdMS_TO_TICKS(entry->period_ms) : 1;
+}
+
+// Nas tarefas que usam rt_monitor_timeout, o início também conta a liberação
+// periódica vencida; um despertar por evento antes dela só abre o ciclo
+void rt_monitor_begin(void) {
+    monitored_task_t *entry = self_entry();
+    if (entry == NULL) {
+        return;
+    }
+    TickType_t increment = period_ticks(entry);
+    TickType_t elapsed = xTaskGetTickCount() - entry->release;
+    if (!entry->released || elapsed < increment) {
+        cycle_begin(entry);
+        return;
+    }
+    TickType_t due = elapsed / increment;
+    if (due > 1) {
+        entry->skipped += due - 1;
+        entry->paced = false;
+    }
+    entry->release += due * increment;
+    paced_begin(entry, increment);
+}
+
+void rt_monitor_end(void) {
+    monitored_task_t *entry = self_entry();
+    if (entry != NULL) {
+        cycle_end(entry);
+    }
+}
+
+void rt_monitor_wait_ms(uint32_t interval_ms) {
+    TickType_t increment = pdMS_TO_TICKS(interval_ms) > 0 ? pdMS_TO_TICKS(interval_ms) : 1;
+    monitored_task_t *entry = self_entry();
+
+    if (entry == NULL) {
+        vTaskDelay(increment);
+        return;
+    }
+    cycle_end(entry);
+
+    // Com mais de um período de atraso, as liberações vencidas são contadas e
+    // descartadas em vez de executadas em sequência para recuperar o atraso
+    TickType_t now = xTaskGetTickCount();
+    if (!entry->released) {
+        entry->release = now;
+        entry->released = true;
+    } else if ((TickType_t)(now - entry->release) > increment) {
+        TickType_t lost = (TickType_t)(now - entry->release - 1) / increment;
+        entry->skipped += lost;
+        entry->release += lost * increment;
+        entry->paced = false;
+    }
+    vTaskDelayUntil(&entry->release, increment);
+    paced_begin(entry, increment);
+}
+
+void rt_monitor_wait(void) {
+    monitored_task_t *entry = self_entry();
+    rt_monitor_wait_ms(entry != NULL ? entry->period_ms : 1);
+}
+
+TickType_t rt_monitor_timeout(void) {
+    monitored_task_t *entry = self_entry();
+    if (entry == NULL) {
+        return 1;
+    }
+    TickType_t now = xTaskGetTickCount();
+    if (!entry->released) {
+        entry->release = now;
+        entry->released = true;
+    }
+    TickType_t increment = period_ticks(entry);
+    TickType_t elapsed = now - entry->release;
+    return elapsed >= increment ? 0 : increment - elapsed;
+}
+
+uint32_t rt_monitor_release_us(void) {
+    monitored_task_t *entry = self_entry();
+    return entry != NULL && entry->open ? entry->release_us : time_us_32();
+}
+
+uint8_t rt_monitor_count(void) {
+    return monitored_count;
+}
+
+bool rt_monitor_get(uint8_t index, rt_monitor_entry_t *entry) {
+    if (index >= monitored_count) {
+        return false;
+    }
+    const monitored_task_t *task = &monitored[index];
+    entry->name = task->name;
+    entry->period_ms = task->period_ms;
+    entry->deadline_ms = task->deadline_ms;
+    entry->cycles = task->cycles;
+    entry->misses = task->misses;
+    entry->skipped = task->skipped;
+    entry->max_response_us = task->max_response_us;
+    entry->max_jitter_us = task->max_jitter_us;
+    return true;
+}
+
+uint32_t rt_monitor_total_misses(void) {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < monitored_count; i++) {
+        total += monitored[i].misses;
+    }
+    return total;
+}
+
+// Zera os contadores; o jitter volta a ser medido a partir da próxima liberação
+void rt_monitor_reset(void) {
+    for (uint8_t i = 0; i < monitored_count; i++) {
+        monitored[i].cycles = 0;
+        monitored[i].misses = 0;
+        monitored[i].skipped = 0;
+        monitored[i].max_response_us = 0;
+        monitored[i].max_jitter_us = 0;
+        monitored[i].paced = false;
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef RT_MONITOR_H
+#define RT_MONITOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Monitor de tempo real: cada tarefa declara período e prazo, marca o início e o fim
+// de cada ciclo e dorme até a próxima liberação com vTaskDelayUntil, sem acumular o
+// tempo de execução no período. O monitor conta ciclos, prazos perdidos (resposta
+// maior que o prazo), liberações perdidas (ciclo mais longo que o período) e o jitter
+// de liberação (maior desvio entre o intervalo real de início e o esperado).
+#define RT_MONITOR_MAX_TASKS 10
+
+// Estatísticas de uma tarefa monitorada
+typedef struct {
+    const char *name;
+    uint32_t period_ms;
+    uint32_t deadline_ms;
+    uint32_t cycles;
+    uint32_t misses;           // Ciclos concluídos depois do prazo
+    uint32_t skipped;          // Liberações perdidas por atraso maior que o período
+    uint32_t max_response_us;  // Maior tempo entre o início e o fim de um ciclo
+    uint32_t max_jitter_us;    // Maior desvio do intervalo entre inícios de ciclo
+} rt_monitor_entry_t;
+
+bool rt_monitor_watch(TaskHandle_t task, const char *name, uint32_t period_ms, uint32_t deadline_ms);
+
+// Início e fim de um ciclo da tarefa chamadora (sem efeito se ela não for monitorada).
+// Tarefas esporádicas, liberadas por fila ou caixa, usam apenas estas duas.
+void rt_monitor_begin(void);
+void rt_monitor_end(void);
+
+// Fecha o ciclo (se aberto), dorme até a próxima liberação e abre o ciclo seguinte.
+// rt_monitor_wait usa o período declarado; rt_monitor_wait_ms, um intervalo variável
+// contado da liberação anterior (amostragem adaptativa).
+void rt_monitor_wait(void);
+void rt_monitor_wait_ms(uint32_t interval_ms);
+
+// Tarefas que acordam por evento ou, no máximo, a cada período (display): tempo até
+// a próxima liberação periódica, para usar como timeout da fila ou caixa, seguido de
+// rt_monitor_begin ao acordar (1 tick se a tarefa não for monitorada)
+TickType_t rt_monitor_timeout(void);
+
+// Instante (time_us_32) da liberação do ciclo em andamento da tarefa chamadora, com
+// resolução de um tick nas tarefas periódicas; o instante atual sem ciclo aberto
+uint32_t rt_monitor_release_us(void);
+
+uint8_t rt_monitor_count(void);
+bool rt_monitor_get(uint8_t index, rt_monitor_entry_t *entry);
+uint32_t rt_monitor_total_misses(void);
+void rt_monitor_reset(void);
+
+#endif
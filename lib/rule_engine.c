@@ -0,0 +1,390 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rule_engine.h"
+#include "sensor_channel.h"
+#include "prediction.h"
+
+static const char *const action_names[] = { "-", "atencao", "alerta", "critico", "piora" };
+
+static const struct {
+    const char *text;
+    uint8_t op;
+} comparisons[] = {
+    { ">", RULE_OP_GT },
+    { ">=", RULE_OP_GE },
+    { "<", RULE_OP_LT },
+    { "<=", RULE_OP_LE },
+};
+
+// Estado do compilador: tokens de entrada e programa em construção
+typedef struct {
+    rule_t *rule;
+    const char *const *tokens;
+    int count;
+    int pos;
+    uint8_t const_count;
+} parser_t;
+
+static const char *peek(const parser_t *p) {
+    return p->pos < p->count ? p->tokens[p->pos] : NULL;
+}
+
+static bool accept(parser_t *p, const char *word) {
+    const char *token = peek(p);
+    if (token != NULL && strcmp(token, word) == 0) {
+        p->pos++;
+        return true;
+    }
+    return false;
+}
+
+static bool emit(parser_t *p, uint8_t op, uint8_t arg) {
+    if (p->rule->length >= RULE_CODE_MAX) {
+        return false;
+    }
+    p->rule->code[p->rule->length].op = op;
+    p->rule->code[p->rule->length].arg = arg;
+    p->rule->length++;
+    return true;
+}
+
+static bool parse_number(const char *text, float *value) {
+    char *end;
+    *value = strtof(text, &end);
+    return end != text && *end == '\0';
+}
+
+// operando := modo | canal | canal.taxa | canal.tc
+static bool parse_operand(parser_t *p) {
+    const char *token = peek(p);
+    char name[16];
+
+    if (token == NULL) {
+        return false;
+    }
+    if (strcmp(token, "modo") == 0) {
+        p->pos++;
+        return emit(p, RULE_OP_LOAD, RULE_FIELD_MODE << 4);
+    }
+
+    const char *dot = strchr(token, '.');
+    size_t length = dot != NULL ? (size_t)(dot - token) : strlen(token);
+    if (length == 0 || length >= sizeof(name)) {
+        return false;
+    }
+    memcpy(name, token, length);
+    name[length] = '\0';
+
+    rule_field_t field = RULE_FIELD_VALUE;
+    if (dot != NULL) {
+        if (strcmp(dot + 1, "taxa") == 0) {
+            field = RULE_FIELD_RATE;
+        } else if (strcmp(dot + 1, "tc") == 0) {
+            field = RULE_FIELD_TTC;
+        } else {
+            return false;
+        }
+    }
+
+    int channel = sensor_channel_find(name);
+    if (channel < 0 || channel > 0x0F) {
+        return false;
+    }
+    p->pos++;
+    return emit(p, RULE_OP_LOAD, (uint8_t)(field << 4 | channel));
+}
+
+// fator := nao fator | operando comparação número
+static bool parse_factor(parser_t *p) {
+    if (accept(p, "nao")) {
+        return parse_factor(p) && emit(p, RULE_OP_NOT, 0);
+    }
+    if (!parse_operand(p)) {
+        return false;
+    }
+
+    const char *token = peek(p);
+    int op = -1;
+    for (size_t i = 0; token != NULL && i < sizeof(comparisons) / sizeof(comparisons[0]); i++) {
+        if (strcmp(token, comparisons[i].text) == 0) {
+            op = comparisons[i].op;
+        }
+    }
+    if (op < 0) {
+        return false;
+    }
+    p->pos++;
+
+    float value;
+    token = peek(p);
+    if (token == NULL || !parse_number(token, &value) || p->const_count >= RULE_CONST_MAX) {
+        return false;
+    }
+    p->pos++;
+    p->rule->constants[p->const_count] = value;
+    return emit(p, RULE_OP_CONST, p->const_count++) && emit(p, (uint8_t)op, 0);
+}
+
+// termo := fator { e fator }
+static bool parse_term(parser_t *p) {
+    if (!parse_factor(p)) {
+        return false;
+    }
+    while (accept(p, "e")) {
+        if (!parse_factor(p) || !emit(p, RULE_OP_AND, 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// expressão := termo { ou termo }
+static bool parse_expression(parser_t *p) {
+    if (!parse_term(p)) {
+        return false;
+    }
+    while (accept(p, "ou")) {
+        if (!parse_term(p) || !emit(p, RULE_OP_OR, 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void rule_clear(rule_t *rule) {
+    memset(rule, 0, sizeof(*rule));
+}
+
+// regra := expressão [por segundos] ação
+bool rule_compile(rule_t *rule, const char *const *tokens, int count, int *error_token) {
+    parser_t p = { .rule = rule, .tokens = tokens, .count = count };
+
+    rule_clear(rule);
+    bool ok = parse_expression(&p);
+
+    if (ok && accept(&p, "por")) {
+        float seconds;
+        const char *token = peek(&p);
+        ok = token != NULL && parse_number(token, &seconds) && seconds >= 0.0f && seconds <= UINT16_MAX;
+        if (ok) {
+            rule->hold_s = (uint16_t)seconds;
+            p.pos++;
+        }
+    }
+
+    if (ok) {
+        const char *token = peek(&p);
+        ok = false;
+        for (uint8_t a = RULE_ACTION_WARNING; token != NULL && a <= RULE_ACTION_WORSENING; a++) {
+            if (strcmp(token, action_names[a]) == 0) {
+                rule->action = a;
+                ok = true;
+            }
+        }
+        if (ok) {
+            p.pos++;
+        }
+    }
+
+    ok = ok && p.pos == count && rule_verify(rule);
+    if (!ok) {
+        if (error_token != NULL) {
+            *error_token = p.pos;
+        }
+        rule_clear(rule);
+    }
+    return ok;
+}
+
+bool rule_verify(const rule_t *rule) {
+    int depth = 0;
+
+    if (rule->length == 0 || rule->length > RULE_CODE_MAX ||
+        rule->action < RULE_ACTION_WARNING || rule->action > RULE_ACTION_WORSENING) {
+        return false;
+    }
+    for (int i = 0; i < rule->length; i++) {
+        rule_insn_t insn = rule->code[i];
+        switch (insn.op) {
+            case RULE_OP_LOAD:
+                if ((insn.arg >> 4) > RULE_FIELD_MODE ||
+                    ((insn.arg >> 4) != RULE_FIELD_MODE && (insn.arg & 0x0F) >= sensor_channel_count())) {
+                    return false;
+                }
+                depth++;
+                break;
+            case RULE_OP_CONST:
+                if (insn.arg >= RULE_CONST_MAX) {
+                    return false;
+                }
+                depth++;
+                break;
+            case RULE_OP_NOT:
+                if (depth < 1) {
+                    return false;
+                }
+                break;
+            case RULE_OP_GT:
+            case RULE_OP_GE:
+            case RULE_OP_LT:
+            case RULE_OP_LE:
+            case RULE_OP_AND:
+            case RULE_OP_OR:
+                if (depth < 2) {
+                    return false;
+                }
+                depth--;
+                break;
+            default:
+                return false;
+        }
+        if (depth > RULE_STACK_MAX) {
+            return false;
+        }
+    }
+    return depth == 1;
+}
+
+static float load(const sensor_data_t *data, uint8_t arg) {
+    uint8_t channel = arg & 0x0F;
+
+    if ((arg >> 4) == RULE_FIELD_MODE) {
+        return (float)data->mode;
+    }
+    if (channel >= data->channel_count) {
+        return NAN;
+    }
+    switch (arg >> 4) {
+        case RULE_FIELD_RATE:
+            return data->rate[channel];
+        case RULE_FIELD_TTC:
+            return data->channel_ttc[channel] == PREDICTION_NONE ? INFINITY : (float)data->channel_ttc[channel];
+        default:
+            return data->value[channel];
+    }
+}
+
+// Executa o programa já verificado: sem desvios e sem checagem de pilha em tempo de execução
+static bool rule_condition(const rule_t *rule, const sensor_data_t *data) {
+    float stack[RULE_STACK_MAX];
+    int sp = 0;
+
+    for (int i = 0; i < rule->length; i++) {
+        rule_insn_t insn = rule->code[i];
+        switch (insn.op) {
+            case RULE_OP_LOAD:
+                stack[sp++] = load(data, insn.arg);
+                break;
+            case RULE_OP_CONST:
+                stack[sp++] = rule->constants[insn.arg];
+                break;
+            case RULE_OP_GT:
+                sp--;
+                stack[sp - 1] = stack[sp - 1] > stack[sp];
+                break;
+            case RULE_OP_GE:
+                sp--;
+                stack[sp - 1] = stack[sp - 1] >= stack[sp];
+                break;
+            case RULE_OP_LT:
+                sp--;
+                stack[sp - 1] = stack[sp - 1] < stack[sp];
+                break;
+            case RULE_OP_LE:
+                sp--;
+                stack[sp - 1] = stack[sp - 1] <= stack[sp];
+                break;
+            case RULE_OP_AND:
+                sp--;
+                stack[sp - 1] = stack[sp - 1] != 0.0f && stack[sp] != 0.0f;
+                break;
+            case RULE_OP_OR:
+                sp--;
+                stack[sp - 1] = stack[sp - 1] != 0.0f || stack[sp] != 0.0f;
+                break;
+            case RULE_OP_NOT:
+                stack[sp - 1] = stack[sp - 1] == 0.0f;
+                break;
+        }
+    }
+    return stack[0] != 0.0f;
+}
+
+// Todas as condições veem o modo dos limiares; as ações são aplicadas ao final,
+// então o resultado não depende da ordem das regras
+uint8_t rule_set_evaluate(rule_set_t *set, sensor_data_t *data, uint32_t now_ms) {
+    SystemMode mode = data->mode;
+    bool worsening = false;
+    uint8_t active = 0;
+
+    for (int i = 0; i < RULE_MAX; i++) {
+        rule_t *rule = &set->rules[i];
+        if (rule->length == 0) {
+            continue;
+        }
+
+        if (!rule_condition(rule, data)) {
+            rule->armed = false;
+            rule->active = false;
+            continue;
+        }
+        if (!rule->armed) {
+            rule->armed = true;
+            rule->true_since_ms = now_ms;
+        }
+        if (!rule->active && now_ms - rule->true_since_ms >= rule->hold_s * 1000u) {
+            rule->active = true;
+            rule->fired++;
+        }
+        if (rule->active) {
+            active++;
+            if (rule->action == RULE_ACTION_WORSENING) {
+                worsening = true;
+            } else if (rule->action > mode) {
+                mode = (SystemMode)rule->action;
+            }
+        }
+    }
+
+    data->mode = mode;
+    data->trend_worsening = data->trend_worsening || worsening;
+    return active;
+}
+
+void rule_format(const rule_t *rule, char *buffer, size_t size) {
+    static const char *const op_text[RULE_OP_COUNT] = { NULL, NULL, ">", ">=", "<", "<=", "e", "ou", "nao" };
+    size_t used = 0;
+
+    buffer[0] = '\0';
+    for (int i = 0; i < rule->length && used < size; i++) {
+        rule_insn_t insn = rule->code[i];
+        const char *separator = i > 0 ? " " : "";
+        int n;
+
+        if (insn.op == RULE_OP_LOAD) {
+            static const char *const suffix[] = { "", ".taxa", ".tc" };
+            const sensor_channel_t *channel = sensor_channel_get(insn.arg & 0x0F);
+            if ((insn.arg >> 4) == RULE_FIELD_MODE) {
+                n = snprintf(buffer + used, size - used, "%smodo", separator);
+            } else {
+                n = snprintf(buffer + used, size - used, "%s%s%s", separator,
+                             channel != NULL ? channel->name : "?", suffix[insn.arg >> 4]);
+            }
+        } else if (insn.op == RULE_OP_CONST) {
+            n = snprintf(buffer + used, size - used, "%s%g", separator, (double)rule->constants[insn.arg]);
+        } else {
+            n = snprintf(buffer + used, size - used, "%s%s", separator,
+                         insn.op < RULE_OP_COUNT && op_text[insn.op] != NULL ? op_text[insn.op] : "?");
+        }
+        if (n < 0) {
+            break;
+        }
+        used += (size_t)n;
+    }
+}
+
+const char *rule_action_name(uint8_t action) {
+    return action <= RULE_ACTION_WORSENING ? action_names[action] : "?";
+}
@@ -0,0 +1,88 @@
+#ifndef RULE_ENGINE_H
+#define RULE_ENGINE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "sensor_data.h"
+
+// Regras de alerta do local, escritas em texto e compiladas para um bytecode de pilha.
+// Exemplo (tokens separados por espaço):
+//   nivel > 60 e nivel.taxa > 2 por 30 alerta
+// Operandos: canal (valor), canal.taxa (unidade/min), canal.tc (s até o crítico) e modo
+// (modo dos limiares). Conectivos: e, ou, nao. "por S" exige a condição verdadeira por S
+// segundos seguidos. Ação: atencao, alerta, critico (eleva o modo) ou piora (tendência).
+//
+// O programa não tem desvios, então a avaliação custa no máximo RULE_CODE_MAX
+// instruções por regra, e o compilador verifica a profundidade da pilha.
+#define RULE_MAX 8
+#define RULE_CODE_MAX 16
+#define RULE_CONST_MAX 4
+#define RULE_STACK_MAX 4
+
+typedef enum {
+    RULE_OP_LOAD,              // arg = campo << 4 | canal
+    RULE_OP_CONST,             // arg = índice da constante
+    RULE_OP_GT,
+    RULE_OP_GE,
+    RULE_OP_LT,
+    RULE_OP_LE,
+    RULE_OP_AND,
+    RULE_OP_OR,
+    RULE_OP_NOT,
+    RULE_OP_COUNT
+} rule_op_t;
+
+typedef enum {
+    RULE_FIELD_VALUE,
+    RULE_FIELD_RATE,
+    RULE_FIELD_TTC,            // Sem previsão vale +infinito
+    RULE_FIELD_MODE            // Modo consolidado pelos limiares (ignora o canal)
+} rule_field_t;
+
+typedef enum {
+    RULE_ACTION_WARNING = WARNING_MODE,
+    RULE_ACTION_ALERT = ALERT_MODE,
+    RULE_ACTION_CRITICAL = CRITICAL_MODE,
+    RULE_ACTION_WORSENING
+} rule_action_t;
+
+typedef struct {
+    uint8_t op;
+    uint8_t arg;
+} rule_insn_t;
+
+typedef struct {
+    rule_insn_t code[RULE_CODE_MAX];
+    float constants[RULE_CONST_MAX];
+    uint8_t length;            // Instruções do programa (0 = posição vazia)
+    uint8_t action;            // rule_action_t
+    uint16_t hold_s;           // Tempo mínimo com a condição verdadeira
+    bool armed;                // Condição verdadeira desde true_since_ms
+    bool active;               // Ação aplicada
+    uint32_t true_since_ms;
+    uint32_t fired;            // Ativações desde o carregamento
+} rule_t;
+
+typedef struct {
+    rule_t rules[RULE_MAX];
+} rule_set_t;
+
+// Compila os tokens de uma regra; em erro devolve false e o índice do token
+// problemático em error_token (count quando falta algo no fim)
+bool rule_compile(rule_t *rule, const char *const *tokens, int count, int *error_token);
+
+// Confere opcodes, canais registrados e pilha de um programa (também para regras restauradas)
+bool rule_verify(const rule_t *rule);
+
+void rule_clear(rule_t *rule);
+
+// Avalia as regras sobre o bloco consolidado e aplica as ações ativas; devolve quantas estão ativas
+uint8_t rule_set_evaluate(rule_set_t *set, sensor_data_t *data, uint32_t now_ms);
+
+// Escreve o programa em notação pós-fixa ("nivel 60 > nivel.taxa 2 > e")
+void rule_format(const rule_t *rule, char *buffer, size_t size);
+
+const char *rule_action_name(uint8_t action);
+
+#endif
@@ -0,0 +1,108 @@
+#include <stddef.h>
+#include "sample_pool.h"
+
+// Seção crítica curta em torno das contagens de referência
+#ifdef SAMPLE_POOL_HOST
+// No host o benchmark fornece o modelo da seção crítica (tools/bench_pool.c)
+void sample_pool_host_lock(void);
+void sample_pool_host_unlock(void);
+#define POOL_LOCK() sample_pool_host_lock()
+#define POOL_UNLOCK() sample_pool_host_unlock()
+#else
+#include "FreeRTOS.h"
+#include "task.h"
+#define POOL_LOCK() taskENTER_CRITICAL()
+#define POOL_UNLOCK() taskEXIT_CRITICAL()
+#endif
+
+// Blocos de tamanho fixo, contagem de referências e pilha de livres
+static sensor_data_t blocks[SAMPLE_POOL_SIZE];
+static uint8_t refcount[SAMPLE_POOL_SIZE];
+static sample_ref_t free_stack[SAMPLE_POOL_SIZE];
+static uint8_t free_top = 0;
+static sample_ref_t latest = SAMPLE_REF_NONE;
+static uint32_t alloc_failures = 0;
+
+void sample_pool_init(void) {
+    for (int i = 0; i < SAMPLE_POOL_SIZE; i++) {
+        refcount[i] = 0;
+        free_stack[i] = (sample_ref_t)(SAMPLE_POOL_SIZE - 1 - i);
+    }
+    free_top = SAMPLE_POOL_SIZE;
+    latest = SAMPLE_REF_NONE;
+    alloc_failures = 0;
+}
+
+// Reserva um bloco com uma referência (do chamador), ou SAMPLE_REF_NONE se esgotado
+sample_ref_t sample_pool_alloc(void) {
+    sample_ref_t ref = SAMPLE_REF_NONE;
+
+    POOL_LOCK();
+    if (free_top > 0) {
+        ref = free_stack[--free_top];
+        refcount[ref] = 1;
+    } else {
+        alloc_failures++;
+    }
+    POOL_UNLOCK();
+    return ref;
+}
+
+// Acrescenta uma referência (ex.: antes de enviar o bloco para outra fila)
+void sample_pool_retain(sample_ref_t ref) {
+    if (ref >= SAMPLE_POOL_SIZE) {
+        return;
+    }
+    POOL_LOCK();
+    refcount[ref]++;
+    POOL_UNLOCK();
+}
+
+// Libera uma referência; o bloco volta ao pool quando a última é liberada
+void sample_pool_release(sample_ref_t ref) {
+    if (ref >= SAMPLE_POOL_SIZE) {
+        return;
+    }
+    POOL_LOCK();
+    if (refcount[ref] > 0 && --refcount[ref] == 0) {
+        free_stack[free_top++] = ref;
+    }
+    POOL_UNLOCK();
+}
+
+sensor_data_t *sample_pool_get(sample_ref_t ref) {
+    return ref < SAMPLE_POOL_SIZE ? &blocks[ref] : NULL;
+}
+
+// Publica o bloco como amostra mais recente (o bloco não deve mais ser alterado)
+void sample_pool_publish(sample_ref_t ref) {
+    sample_ref_t previous;
+
+    sample_pool_retain(ref);
+    POOL_LOCK();
+    previous = latest;
+    latest = ref;
+    POOL_UNLOCK();
+    sample_pool_release(previous);
+}
+
+// Obtém uma referência para a amostra mais recente (liberar após o uso)
+sample_ref_t sample_pool_acquire_latest(void) {
+    sample_ref_t ref;
+
+    POOL_LOCK();
+    ref = latest;
+    if (ref != SAMPLE_REF_NONE) {
+        refcount[ref]++;
+    }
+    POOL_UNLOCK();
+    return ref;
+}
+
+uint8_t sample_pool_free_count(void) {
+    return free_top;
+}
+
+uint32_t sample_pool_alloc_failures(void) {
+    return alloc_failures;
+}
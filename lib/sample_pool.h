@@ -0,0 +1,27 @@
+#ifndef SAMPLE_POOL_H
+#define SAMPLE_POOL_H
+
+#include "sensor_data.h"
+
+// Blocos disponíveis: produtor, filas, amostra mais recente e consumidores
+#ifndef SAMPLE_POOL_SIZE
+#define SAMPLE_POOL_SIZE 24
+#endif
+
+// Referência para um bloco do pool (é isso que trafega pelas filas)
+typedef uint8_t sample_ref_t;
+#define SAMPLE_REF_NONE 0xFF
+
+void sample_pool_init(void);
+sample_ref_t sample_pool_alloc(void);
+void sample_pool_retain(sample_ref_t ref);
+void sample_pool_release(sample_ref_t ref);
+sensor_data_t *sample_pool_get(sample_ref_t ref);
+
+void sample_pool_publish(sample_ref_t ref);
+sample_ref_t sample_pool_acquire_latest(void);
+
+uint8_t sample_pool_free_count(void);
+uint32_t sample_pool_alloc_failures(void);
+
+#endif
@@ -0,0 +1,268 @@
+#include <math.h>
+#include <string.h>
+#include "sensor_channel.h"
+#include "prediction.h"
+
+// Registro do firmware e registro em uso
+static sensor_registry_t default_registry = { .current_rate = SENSOR_RATE_NORMAL };
+static sensor_registry_t *registry = &default_registry;
+
+void sensor_registry_init(sensor_registry_t *r) {
+    memset(r, 0, sizeof(*r));
+    r->current_rate = SENSOR_RATE_NORMAL;
+}
+
+void sensor_channels_select(sensor_registry_t *r) {
+    registry = r != NULL ? r : &default_registry;
+}
+
+// Registra um canal e retorna seu índice, ou -1 se o registro estiver cheio
+int sensor_channel_register(const sensor_channel_t *channel) {
+    if (registry->channel_count >= SENSOR_MAX_CHANNELS || channel->read == NULL || channel->period_ms == 0) {
+        return -1;
+    }
+
+    int index = registry->channel_count;
+    registry->channels[index] = *channel;
+    prediction_init(&registry->predictions[index], PREDICTION_TAU_LEVEL_S, PREDICTION_TAU_SLOPE_S);
+    registry->next_due_ms[index] = 0;
+    registry->last_sample_ms[index] = 0;
+    registry->last_value[index] = 0.0f;
+    registry->last_rate[index] = 0.0f;
+    registry->last_ttc[index] = PREDICTION_NONE;
+    registry->last_mode[index] = NORMAL_MODE;
+    registry->channel_count++;
+    return index;
+}
+
+// Acrescenta um estágio ao fim da cadeia de filtros do canal
+bool sensor_channel_add_filter(int index, sensor_filter_fn apply, void *state) {
+    if (index < 0 || index >= registry->channel_count || apply == NULL) {
+        return false;
+    }
+
+    sensor_channel_t *channel = &registry->channels[index];
+    if (channel->filter_count >= SENSOR_MAX_FILTERS) {
+        return false;
+    }
+    channel->filters[channel->filter_count].apply = apply;
+    channel->filters[channel->filter_count].state = state;
+    channel->filter_count++;
+    return true;
+}
+
+uint8_t sensor_channel_count(void) {
+    return registry->channel_count;
+}
+
+const sensor_channel_t *sensor_channel_get(int index) {
+    if (index < 0 || index >= registry->channel_count) {
+        return NULL;
+    }
+    return &registry->channels[index];
+}
+
+int sensor_channel_find(const char *name) {
+    for (int i = 0; i < registry->channel_count; i++) {
+        if (strcmp(registry->channels[i].name, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Determina o modo de um canal a partir dos seus limiares
+SystemMode sensor_channel_classify(const sensor_channel_t *channel, float value) {
+    if (value >= channel->critical) {
+        return CRITICAL_MODE;
+    } else if (value >= channel->alert) {
+        return ALERT_MODE;
+    } else if (value >= channel->warning) {
+        return WARNING_MODE;
+    }
+    return NORMAL_MODE;
+}
+
+// Período efetivo do canal no nível de amostragem atual
+uint32_t sensor_channel_period(int index) {
+    const sensor_channel_t *channel = &registry->channels[index];
+
+    if (!channel->adaptive) {
+        return channel->period_ms;
+    }
+    switch (registry->current_rate) {
+        case SENSOR_RATE_IDLE:
+            return channel->period_ms > SENSOR_IDLE_PERIOD_MS ? channel->period_ms : SENSOR_IDLE_PERIOD_MS;
+        case SENSOR_RATE_FAST:
+            return channel->period_ms < SENSOR_FAST_PERIOD_MS ? channel->period_ms : SENSOR_FAST_PERIOD_MS;
+        case SENSOR_RATE_BURST:
+            return channel->period_ms < SENSOR_BURST_PERIOD_MS ? channel->period_ms : SENSOR_BURST_PERIOD_MS;
+        default:
+            return channel->period_ms;
+    }
+}
+
+void sensor_channels_set_policy(sensor_policy_fn fn) {
+    registry->policy = fn;
+}
+
+sensor_rate_t sensor_channels_rate(void) {
+    return registry->current_rate;
+}
+
+// Nível desejado para o estado consolidado mais recente
+static sensor_rate_t desired_rate(const sensor_data_t *data) {
+    if (data->mode >= ALERT_MODE) {
+        return SENSOR_RATE_BURST;
+    }
+    if (data->mode == WARNING_MODE || data->trend_worsening) {
+        return SENSOR_RATE_FAST;
+    }
+    for (int i = 0; i < registry->channel_count; i++) {
+        if (data->value[i] >= registry->channels[i].warning * SENSOR_APPROACH_MARGIN ||
+            data->rate[i] > registry->channels[i].worsening_rate * 0.5f) {
+            return SENSOR_RATE_NORMAL;
+        }
+    }
+    return SENSOR_RATE_IDLE;
+}
+
+// Sobe de nível na hora (antecipando as próximas amostras) e desce devagar, com histerese
+static void update_rate(const sensor_data_t *data, uint32_t now_ms) {
+    sensor_rate_t desired = desired_rate(data);
+
+    if (desired > registry->current_rate) {
+        registry->current_rate = desired;
+        registry->rate_lowering = false;
+        for (int i = 0; i < registry->channel_count; i++) {
+            uint32_t due = registry->last_sample_ms[i] + sensor_channel_period(i);
+            if (registry->channels[i].adaptive && (int32_t)(registry->next_due_ms[i] - due) > 0) {
+                registry->next_due_ms[i] = due;
+            }
+        }
+    } else if (desired < registry->current_rate) {
+        if (!registry->rate_lowering) {
+            registry->rate_lowering = true;
+            registry->rate_lowering_since_ms = now_ms;
+        } else if (now_ms - registry->rate_lowering_since_ms >= SENSOR_RATE_HOLD_MS) {
+            registry->current_rate = (sensor_rate_t)(registry->current_rate - 1);
+            registry->rate_lowering_since_ms = now_ms;
+        }
+    } else {
+        registry->rate_lowering = false;
+    }
+}
+
+void sensor_channels_snapshot(sensor_channels_snapshot_t *snapshot) {
+    snapshot->channel_count = registry->channel_count;
+    snapshot->rate = (uint8_t)registry->current_rate;
+    for (int i = 0; i < registry->channel_count; i++) {
+        snapshot->mode[i] = registry->last_mode[i];
+        snapshot->predictions[i] = registry->predictions[i];
+    }
+}
+
+// Restaura sobre os canais já registrados; recusa se o registro mudou
+bool sensor_channels_restore(const sensor_channels_snapshot_t *snapshot) {
+    if (snapshot->channel_count != registry->channel_count || snapshot->rate > SENSOR_RATE_BURST) {
+        return false;
+    }
+    registry->current_rate = (sensor_rate_t)snapshot->rate;
+    registry->rate_lowering = false;
+    for (int i = 0; i < registry->channel_count; i++) {
+        registry->last_mode[i] = snapshot->mode[i];
+        registry->predictions[i] = snapshot->predictions[i];
+    }
+    return true;
+}
+
+// Amostra os canais vencidos, atualiza taxas, previsões e modos, e preenche o
+// bloco com o estado mais recente de todos os canais (o bloco pode vir de um
+// pool e não precisa conter a amostra anterior). Retorna o tempo (ms) até o
+// próximo canal vencer, já considerando o nível de amostragem adaptativa.
+uint32_t sensor_channels_sample(sensor_data_t *data, uint32_t now_ms) {
+    uint32_t next_wait = UINT32_MAX;
+
+    data->channel_count = registry->channel_count;
+    for (int i = 0; i < registry->channel_count; i++) {
+        const sensor_channel_t *channel = &registry->channels[i];
+
+        if ((int32_t)(now_ms - registry->next_due_ms[i]) >= 0) {
+            // Leitura e cadeia de filtros
+            float raw = channel->read(channel->ctx);
+            float value = raw;
+            for (int f = 0; f < channel->filter_count; f++) {
+                value = channel->filters[f].apply(channel->filters[f].state, value);
+            }
+
+            // Taxa e previsão com o intervalo real desde a última amostra do canal
+            // (o espaçamento varia com o nível de amostragem)
+            float dt = registry->predictions[i].primed ? (now_ms - registry->last_sample_ms[i]) / 1000.0f : 0.0f;
+            prediction_update(&registry->predictions[i], value, dt);
+            registry->last_sample_ms[i] = now_ms;
+
+            registry->last_value[i] = value;
+            registry->last_rate[i] = registry->predictions[i].slope * 60.0f;
+            registry->last_ttc[i] = prediction_time_to(&registry->predictions[i], channel->critical);
+            registry->last_mode[i] = sensor_channel_classify(channel, value);
+
+            // Mantém a cadência; se houve atraso maior que um período, reagenda a partir de agora
+            uint32_t period = sensor_channel_period(i);
+            registry->next_due_ms[i] += period;
+            if ((int32_t)(now_ms - registry->next_due_ms[i]) >= 0) {
+                registry->next_due_ms[i] = now_ms + period;
+            }
+
+            // Leitura descartada pelos filtros: novas amostras logo em seguida confirmam um
+            // degrau real (que assume a janela) ou o descartam como ruído, sem esperar o período
+            if (channel->confirm_delta > 0.0f && fabsf(value - raw) > channel->confirm_delta) {
+                uint32_t due = now_ms + SENSOR_CONFIRM_PERIOD_MS;
+                if ((int32_t)(registry->next_due_ms[i] - due) > 0) {
+                    registry->next_due_ms[i] = due;
+                }
+            }
+        }
+
+        data->value[i] = registry->last_value[i];
+        data->rate[i] = registry->last_rate[i];
+        data->channel_ttc[i] = registry->last_ttc[i];
+        data->channel_mode[i] = registry->last_mode[i];
+    }
+
+    // Consolida o estado: pior modo e tendência de qualquer canal; o tempo até o crítico
+    // (e o pré-alerta) vem só dos canais de nível (predicts), os demais têm apenas canal.tc
+    data->mode = NORMAL_MODE;
+    data->time_to_critical = PREDICTION_NONE;
+    data->trend_worsening = false;
+    for (int i = 0; i < registry->channel_count; i++) {
+        if (data->channel_mode[i] > data->mode) {
+            data->mode = (SystemMode)data->channel_mode[i];
+        }
+        if (registry->channels[i].predicts && data->channel_ttc[i] != PREDICTION_NONE &&
+            (data->time_to_critical == PREDICTION_NONE || data->channel_ttc[i] < data->time_to_critical)) {
+            data->time_to_critical = data->channel_ttc[i];
+        }
+        if (data->rate[i] > registry->channels[i].worsening_rate) {
+            data->trend_worsening = true;
+        }
+    }
+    data->pre_alert = data->time_to_critical != PREDICTION_NONE && data->time_to_critical < PRE_ALERT_HORIZON_S;
+
+    // Pré-alerta também caracteriza tendência de piora para as saídas
+    data->trend_worsening = data->trend_worsening || data->pre_alert;
+    data->timestamp = now_ms;
+    if (registry->policy != NULL) {
+        registry->policy(data, now_ms);
+    }
+
+    // Ajusta o nível de amostragem e calcula a espera até o próximo canal vencer
+    update_rate(data, now_ms);
+    for (int i = 0; i < registry->channel_count; i++) {
+        uint32_t wait = (int32_t)(registry->next_due_ms[i] - now_ms) > 0 ? registry->next_due_ms[i] - now_ms : 0;
+        if (wait < next_wait) {
+            next_wait = wait;
+        }
+    }
+
+    return registry->channel_count > 0 ? next_wait : 100;
+}
@@ -0,0 +1,132 @@
+#ifndef SENSOR_CHANNEL_H
+#define SENSOR_CHANNEL_H
+
+#include "sensor_data.h"
+#include "prediction.h"
+
+// Número máximo de estágios de filtro por canal
+#ifndef SENSOR_MAX_FILTERS
+#define SENSOR_MAX_FILTERS 3
+#endif
+
+// Pré-alerta quando o limiar crítico é previsto em até 5 minutos
+#ifndef PRE_ALERT_HORIZON_S
+#define PRE_ALERT_HORIZON_S 300
+#endif
+
+// Constantes de tempo do estimador de tendência (s)
+#ifndef PREDICTION_TAU_LEVEL_S
+#define PREDICTION_TAU_LEVEL_S 2
+#endif
+#ifndef PREDICTION_TAU_SLOPE_S
+#define PREDICTION_TAU_SLOPE_S 30
+#endif
+
+// Amostragem adaptativa: períodos dos níveis fora do nominal (ms)
+#ifndef SENSOR_IDLE_PERIOD_MS
+#define SENSOR_IDLE_PERIOD_MS 5000   // 0,2 Hz em NORMAL estável e longe dos limiares
+#endif
+#ifndef SENSOR_FAST_PERIOD_MS
+#define SENSOR_FAST_PERIOD_MS 20     // 50 Hz com limiar de atenção atingido ou tendência de piora
+#endif
+#ifndef SENSOR_BURST_PERIOD_MS
+#define SENSOR_BURST_PERIOD_MS 10    // 100 Hz em ALERT e CRITICAL
+#endif
+#ifndef SENSOR_APPROACH_MARGIN
+#define SENSOR_APPROACH_MARGIN 0.8f  // Fração do limiar de atenção que já conta como aproximação
+#endif
+#ifndef SENSOR_RATE_HOLD_MS
+#define SENSOR_RATE_HOLD_MS 30000    // Tempo em condição mais calma antes de descer um nível
+#endif
+#ifndef SENSOR_CONFIRM_PERIOD_MS
+#define SENSOR_CONFIRM_PERIOD_MS 20  // Reamostragem quando os filtros descartam uma leitura
+#endif
+
+// Níveis de amostragem; sobe imediatamente e desce um nível por SENSOR_RATE_HOLD_MS
+typedef enum {
+    SENSOR_RATE_IDLE,
+    SENSOR_RATE_NORMAL,
+    SENSOR_RATE_FAST,
+    SENSOR_RATE_BURST
+} sensor_rate_t;
+
+// Estado dos canais preservado em reinício a quente: modos, estimadores de tendência
+// e nível de amostragem, para que a escalada continue de onde parou
+typedef struct {
+    uint8_t channel_count;
+    uint8_t rate;                                   // sensor_rate_t
+    uint8_t mode[SENSOR_MAX_CHANNELS];
+    prediction_t predictions[SENSOR_MAX_CHANNELS];
+} sensor_channels_snapshot_t;
+
+// Driver do canal: retorna uma leitura na unidade do canal
+typedef float (*sensor_read_fn)(void *ctx);
+
+// Estágio de filtro: recebe a amostra e retorna o valor filtrado
+typedef float (*sensor_filter_fn)(void *state, float value);
+
+typedef struct {
+    sensor_filter_fn apply;
+    void *state;
+} sensor_filter_t;
+
+// Política sobre o estado consolidado (regras do local), aplicada a cada amostragem
+// antes da amostragem adaptativa; pode elevar o modo e marcar tendência de piora
+typedef void (*sensor_policy_fn)(sensor_data_t *data, uint32_t now_ms);
+
+// Configuração de um canal de sensor
+typedef struct {
+    const char *name;          // Nome curto (telemetria e diagnóstico)
+    sensor_read_fn read;       // Driver de leitura
+    void *ctx;                 // Contexto do driver
+    uint32_t period_ms;        // Intervalo nominal entre amostras
+    bool adaptive;             // Período acompanha o nível de amostragem adaptativa
+    float warning;             // Limiar de atenção
+    float alert;               // Limiar de alerta
+    float critical;            // Limiar crítico
+    float worsening_rate;      // Taxa (unidade/min) que caracteriza piora
+    bool predicts;             // Canal de nível: entra no tempo até o crítico e no pré-alerta do sistema
+    float confirm_delta;       // Diferença bruto × filtrado que antecipa a próxima amostra (0 = desativado)
+    sensor_filter_t filters[SENSOR_MAX_FILTERS];
+    uint8_t filter_count;
+} sensor_channel_t;
+
+// Registro de canais e estado de execução (estrutura de vetores, um índice por canal)
+typedef struct {
+    sensor_channel_t channels[SENSOR_MAX_CHANNELS];
+    uint8_t channel_count;
+    prediction_t predictions[SENSOR_MAX_CHANNELS];
+    uint32_t next_due_ms[SENSOR_MAX_CHANNELS];
+    uint32_t last_sample_ms[SENSOR_MAX_CHANNELS];
+    float last_value[SENSOR_MAX_CHANNELS];
+    float last_rate[SENSOR_MAX_CHANNELS];
+    int32_t last_ttc[SENSOR_MAX_CHANNELS];
+    uint8_t last_mode[SENSOR_MAX_CHANNELS];
+    sensor_rate_t current_rate;            // Amostragem adaptativa
+    bool rate_lowering;
+    uint32_t rate_lowering_since_ms;
+    sensor_policy_fn policy;
+} sensor_registry_t;
+
+// As funções abaixo operam sobre o registro em uso. O firmware usa apenas o registro
+// interno; o simulador no host mantém um registro por estação e alterna entre eles.
+void sensor_registry_init(sensor_registry_t *registry);
+void sensor_channels_select(sensor_registry_t *registry);   // NULL volta ao registro interno
+
+int sensor_channel_register(const sensor_channel_t *channel);
+bool sensor_channel_add_filter(int index, sensor_filter_fn apply, void *state);
+uint8_t sensor_channel_count(void);
+const sensor_channel_t *sensor_channel_get(int index);
+int sensor_channel_find(const char *name);
+
+uint32_t sensor_channels_sample(sensor_data_t *data, uint32_t now_ms);
+SystemMode sensor_channel_classify(const sensor_channel_t *channel, float value);
+sensor_rate_t sensor_channels_rate(void);
+uint32_t sensor_channel_period(int index);
+void sensor_channels_set_policy(sensor_policy_fn policy);
+
+// O chamador garante exclusão com a tarefa de amostragem
+void sensor_channels_snapshot(sensor_channels_snapshot_t *snapshot);
+bool sensor_channels_restore(const sensor_channels_snapshot_t *snapshot);
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef SENSOR_DATA_H
+#define SENSOR_DATA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Número máximo de canais de sensor suportados pelo registro
+#ifndef SENSOR_MAX_CHANNELS
+#define SENSOR_MAX_CHANNELS 16
+#endif
+
+// Definições de estados do sistema
+typedef enum {
+    NORMAL_MODE,
+    WARNING_MODE,
+    ALERT_MODE,
+    CRITICAL_MODE
+} SystemMode;
+
+// Estrutura para controle de alertas
+typedef struct {
+    SystemMode mode;           // Modo de alerta
+    bool update_display;       // Flag para atualização do display
+    bool update_matrix;        // Flag para atualização da matriz
+    bool update_sound;         // Flag para atualização do som
+} alert_control_t;
+
+// Bloco de amostras (estrutura de vetores, um índice por canal)
+typedef struct {
+    uint8_t channel_count;                            // Canais registrados
+    float value[SENSOR_MAX_CHANNELS];                 // Valor filtrado (unidade do canal)
+    float rate[SENSOR_MAX_CHANNELS];                  // Taxa de variação (unidade/min)
+    int32_t channel_ttc[SENSOR_MAX_CHANNELS];         // Segundos até o limiar crítico (-1 = sem previsão)
+    uint8_t channel_mode[SENSOR_MAX_CHANNELS];        // Modo individual do canal (SystemMode)
+    SystemMode mode;           // Modo atual do sistema (pior canal)
+    bool trend_worsening;      // Tendência de piora
+    bool pre_alert;            // Nível crítico previsto dentro do horizonte
+    int32_t time_to_critical;  // Menor tempo previsto entre os canais de nível (-1 = sem previsão)
+    uint32_t timestamp;        // Instante da amostra (ms)
+    uint32_t sampled_us;       // Instante da leitura do ADC (µs), base das medidas de latência
+    alert_control_t alert;     // Decisão de alerta (preenchida pelo processamento)
+} sensor_data_t;
+
+#endif
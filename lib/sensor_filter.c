@@ -0,0 +1,205 @@
+#include <math.h>
+#include "sensor_filter.h"
+
+// Fator que torna o MAD uma estimativa do desvio padrão para ruído gaussiano
+#define MAD_TO_SIGMA 1.4826f
+
+// Acesso ao heap pela posição relativa à mediana
+#define HEAP(f, i) ((f)->heap[(f)->offset + (i)])
+
+// Quantidade de amostras em cada heap
+static inline int min_count(const median_filter_t *f) { return (f->count - 1) / 2; }
+static inline int max_count(const median_filter_t *f) { return f->count / 2; }
+
+static inline bool less_at(const median_filter_t *f, int i, int j) {
+    return f->data[HEAP(f, i)] < f->data[HEAP(f, j)];
+}
+
+static inline void swap_at(median_filter_t *f, int i, int j) {
+    int8_t t = HEAP(f, i);
+    HEAP(f, i) = HEAP(f, j);
+    HEAP(f, j) = t;
+    f->pos[HEAP(f, i)] = (int8_t)i;
+    f->pos[HEAP(f, j)] = (int8_t)j;
+}
+
+// Troca i e j se i < j; devolve se trocou
+static inline bool order(median_filter_t *f, int i, int j) {
+    if (less_at(f, i, j)) {
+        swap_at(f, i, j);
+        return true;
+    }
+    return false;
+}
+
+// Restaura o heap de mínimo a partir do filho i (posições positivas; i = 1 compara com a mediana)
+static void min_sort_down(median_filter_t *f, int i) {
+    for (; i <= min_count(f); i *= 2) {
+        if (i > 1 && i < min_count(f) && less_at(f, i + 1, i)) {
+            i++;
+        }
+        if (!order(f, i, i / 2)) {
+            break;
+        }
+    }
+}
+
+// Restaura o heap de máximo a partir do filho i (posições negativas; i = -1 compara com a mediana)
+static void max_sort_down(median_filter_t *f, int i) {
+    for (; i >= -max_count(f); i *= 2) {
+        if (i < -1 && i > -max_count(f) && less_at(f, i, i - 1)) {
+            i--;
+        }
+        if (!order(f, i / 2, i)) {
+            break;
+        }
+    }
+}
+
+// Sobe o item no heap de mínimo; devolve true se ele chegou à mediana
+static bool min_sort_up(median_filter_t *f, int i) {
+    while (i > 0 && order(f, i, i / 2)) {
+        i /= 2;
+    }
+    return i == 0;
+}
+
+// Sobe o item no heap de máximo; devolve true se ele chegou à mediana
+static bool max_sort_up(median_filter_t *f, int i) {
+    while (i < 0 && order(f, i / 2, i)) {
+        i /= 2;
+    }
+    return i == 0;
+}
+
+bool median_filter_init(median_filter_t *filter, uint8_t window) {
+    if (window == 0 || window > FILTER_WINDOW_MAX) {
+        return false;
+    }
+    filter->window = window;
+    filter->offset = window / 2;
+    filter->count = 0;
+    filter->next = 0;
+
+    // Preenchimento inicial alternado: mediana, máximo, mínimo, máximo...
+    for (int k = window - 1; k >= 0; k--) {
+        filter->pos[k] = (int8_t)(((k + 1) / 2) * ((k & 1) ? -1 : 1));
+        HEAP(filter, filter->pos[k]) = (int8_t)k;
+        filter->data[k] = 0.0f;
+    }
+    return true;
+}
+
+// Substitui a amostra mais antiga e reposiciona apenas ela nos heaps
+float median_filter_update(median_filter_t *f, float value) {
+    bool filling = f->count < f->window;
+    int p = f->pos[f->next];
+    float old = f->data[f->next];
+
+    f->data[f->next] = value;
+    f->next = (uint8_t)((f->next + 1) % f->window);
+    if (filling) {
+        f->count++;
+    }
+
+    if (p > 0) {
+        // Item no heap de mínimo
+        if (!filling && old < value) {
+            min_sort_down(f, p * 2);
+        } else if (min_sort_up(f, p)) {
+            max_sort_down(f, -1);
+        }
+    } else if (p < 0) {
+        // Item no heap de máximo
+        if (!filling && value < old) {
+            max_sort_down(f, p * 2);
+        } else if (max_sort_up(f, p)) {
+            min_sort_down(f, 1);
+        }
+    } else {
+        // Item na mediana
+        if (max_count(f)) {
+            max_sort_down(f, -1);
+        }
+        if (min_count(f)) {
+            min_sort_down(f, 1);
+        }
+    }
+    return median_filter_value(f);
+}
+
+float median_filter_value(const median_filter_t *f) {
+    float v = f->data[HEAP(f, 0)];
+    if (f->count > 0 && (f->count & 1) == 0) {
+        v = 0.5f * (v + f->data[HEAP(f, -1)]);
+    }
+    return v;
+}
+
+float median_filter_apply(void *state, float value) {
+    return median_filter_update((median_filter_t *)state, value);
+}
+
+bool hampel_filter_init(hampel_filter_t *filter, uint8_t window, float k, float min_deviation) {
+    filter->k = k;
+    filter->min_deviation = min_deviation;
+    filter->rejected = 0;
+    return median_filter_init(&filter->median, window);
+}
+
+// k-ésimo menor valor (0 = menor) por seleção parcial; reordena o vetor
+static float select_kth(float *v, int n, int k) {
+    int lo = 0, hi = n - 1;
+    while (lo < hi) {
+        float pivot = v[(lo + hi) / 2];
+        int i = lo, j = hi;
+        while (i <= j) {
+            while (v[i] < pivot) i++;
+            while (v[j] > pivot) j--;
+            if (i <= j) {
+                float t = v[i];
+                v[i] = v[j];
+                v[j] = t;
+                i++;
+                j--;
+            }
+        }
+        if (k <= j) {
+            hi = j;
+        } else if (k >= i) {
+            lo = i;
+        } else {
+            break;
+        }
+    }
+    return v[k];
+}
+
+// A mediana vem dos heaps em O(log n). O MAD depende da mediana atual e não tem forma
+// incremental; com a janela limitada a FILTER_WINDOW_MAX ele é obtido por seleção
+// linear sobre os desvios.
+float hampel_filter_apply(void *state, float value) {
+    hampel_filter_t *f = (hampel_filter_t *)state;
+    median_filter_t *m = &f->median;
+    float median = median_filter_update(m, value);
+
+    if (m->count < 3) {
+        return value;
+    }
+
+    float deviation[FILTER_WINDOW_MAX];
+    for (int i = 0; i < m->count; i++) {
+        deviation[i] = fabsf(m->data[i] - median);
+    }
+    float mad = select_kth(deviation, m->count, m->count / 2);
+
+    float limit = f->k * MAD_TO_SIGMA * mad;
+    if (limit < f->min_deviation) {
+        limit = f->min_deviation;
+    }
+    if (fabsf(value - median) > limit) {
+        f->rejected++;
+        return median;
+    }
+    return value;
+}
@@ -0,0 +1,45 @@
+#ifndef SENSOR_FILTER_H
+#define SENSOR_FILTER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Estágios de filtro para a cadeia dos canais (sensor_channel_add_filter), aplicados entre
+// a leitura bruta e a classificação de modo. Todos usam buffers de tamanho fixo.
+#define FILTER_WINDOW_MAX 15
+
+// Mediana móvel: janela circular com dois heaps indexados (máximo abaixo da mediana,
+// mínimo acima), ambos em um único vetor centrado na mediana. Cada amostra substitui a
+// mais antiga no próprio lugar do heap e é reposicionada em O(log n).
+typedef struct {
+    float data[FILTER_WINDOW_MAX];     // Janela circular de amostras
+    int8_t pos[FILTER_WINDOW_MAX];     // Posição de cada amostra no heap (<0 máx, 0 mediana, >0 mín)
+    int8_t heap[FILTER_WINDOW_MAX];    // Índices da janela; heap[offset + i] é a posição i
+    uint8_t offset;                    // Deslocamento da mediana no vetor heap
+    uint8_t window;
+    uint8_t count;
+    uint8_t next;                      // Próxima posição da janela a ser substituída
+} median_filter_t;
+
+// Detector de Hampel: uma amostra que se afasta da mediana da janela mais que
+// k × 1,4826 × MAD (desvio absoluto mediano, estimativa robusta do desvio padrão) é
+// trocada pela mediana; as demais passam sem atraso. min_deviation evita que ruído
+// mínimo seja tratado como anomalia quando a janela está constante (MAD = 0).
+typedef struct {
+    median_filter_t median;
+    float k;
+    float min_deviation;
+    uint32_t rejected;                 // Amostras substituídas pela mediana
+} hampel_filter_t;
+
+bool median_filter_init(median_filter_t *filter, uint8_t window);
+float median_filter_update(median_filter_t *filter, float value);
+float median_filter_value(const median_filter_t *filter);
+
+bool hampel_filter_init(hampel_filter_t *filter, uint8_t window, float k, float min_deviation);
+
+// Assinatura de sensor_filter_fn
+float median_filter_apply(void *state, float value);
+float hampel_filter_apply(void *state, float value);
+
+#endif
@@ -0,0 +1,43 @@
+#include <string.h>
+#include "sparkline.h"
+
+void sparkline_init(sparkline_t *sparkline) {
+    memset(sparkline, 0, sizeof(*sparkline));
+}
+
+// Coluna preenchida de baixo para cima: o bit 7 é a linha inferior da página
+static uint8_t column_for(uint8_t percent) {
+    uint8_t height = (uint8_t)((percent * 8 + 50) / 100);
+    return height ? (uint8_t)(0xFF << (8 - height)) : 0;
+}
+
+// Consome as posições novas do histórico; devolve quantas colunas entraram
+uint32_t sparkline_sync(sparkline_t *sparkline, const history_t *history) {
+    uint32_t count = history->count;
+    uint32_t oldest = history_oldest(history);
+    uint32_t added = 0;
+
+    // Leitor atrasado além do tamanho do histórico: pula para a posição mais antiga
+    if (sparkline->seq < oldest) {
+        sparkline->seq = oldest;
+    }
+    while (sparkline->seq != count) {
+        sparkline->columns[sparkline->head] = column_for(history_get(history, sparkline->seq));
+        sparkline->head = (sparkline->head + 1) % SPARKLINE_COLUMNS;
+        sparkline->seq++;
+        added++;
+    }
+    return added;
+}
+
+// Copia as colunas, da mais antiga à mais recente, para a página indicada
+void sparkline_draw(ssd1306_t *display, const sparkline_t *sparkline, uint8_t page) {
+    uint8_t width = display->width < SPARKLINE_COLUMNS ? display->width : SPARKLINE_COLUMNS;
+    uint8_t column = (uint8_t)((sparkline->head + SPARKLINE_COLUMNS - width) % SPARKLINE_COLUMNS);
+
+    for (uint8_t x = 0; x < width; x++) {
+        // Endereçamento vertical: mesmo índice de ssd1306_pixel
+        display->ram_buffer[page + (x << 3) + 1] = sparkline->columns[column];
+        column = (column + 1) % SPARKLINE_COLUMNS;
+    }
+}
@@ -0,0 +1,24 @@
+#ifndef SPARKLINE_H
+#define SPARKLINE_H
+
+#include <stdint.h>
+#include "ssd1306.h"
+#include "history.h"
+
+// Gráfico rolante de uma página (8 px de altura) a partir de um histórico. As colunas
+// ficam em um buffer circular já no formato da RAM do display (um byte por coluna):
+// cada nova posição do histórico gera um único byte, e o desenho é uma cópia de 128
+// bytes para a página escolhida, sem replotar o gráfico com ssd1306_line.
+#define SPARKLINE_COLUMNS 128
+
+typedef struct {
+    uint8_t columns[SPARKLINE_COLUMNS];
+    uint8_t head;              // Próxima coluna a escrever (também a mais antiga)
+    uint32_t seq;              // Próxima posição do histórico a consumir
+} sparkline_t;
+
+void sparkline_init(sparkline_t *sparkline);
+uint32_t sparkline_sync(sparkline_t *sparkline, const history_t *history);
+void sparkline_draw(ssd1306_t *display, const sparkline_t *sparkline, uint8_t page);
+
+#endif
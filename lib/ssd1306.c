@@ -1,71 +1,166 @@
+#include <string.h>
 #include "ssd1306.h"
 #include "font.h"
 
+// Transporte padrão: escrita bloqueante direta no periférico I2C
+static int ssd1306_i2c_write(void *ctx, uint8_t address, const uint8_t *src, size_t len) {
+  return i2c_write_blocking((i2c_inst_t *)ctx, address, src, len, false);
+}
+
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+  uint8_t *buffer = calloc(SSD1306_BUFFER_SIZE(width, height), sizeof(uint8_t));
+  ssd1306_init_with_buffer(ssd, width, height, external_vcc, address, i2c, buffer);
+}
+
+// Inicializa usando um buffer fornecido pelo chamador (SSD1306_BUFFER_SIZE bytes)
+void ssd1306_init_with_buffer(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c, uint8_t *buffer) {
   ssd->width = width;
   ssd->height = height;
   ssd->pages = height / 8U;
   ssd->address = address;
   ssd->i2c_port = i2c;
-  ssd->bufsize = ssd->pages * ssd->width + 1;
-  ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
+  ssd->external_vcc = external_vcc;
+  ssd->bufsize = SSD1306_BUFFER_SIZE(width, height);
+  ssd->ram_buffer = buffer;
+  memset(ssd->ram_buffer, 0, ssd->bufsize);
   ssd->ram_buffer[0] = 0x40;
   ssd->port_buffer[0] = 0x80;
+
+  // Janela de colunas e páginas do quadro inteiro, prefixada pelo byte de controle
+  ssd->window_cmds[0] = 0x00;
+  ssd->window_cmds[1] = SET_COL_ADDR;
+  ssd->window_cmds[2] = 0;
+  ssd->window_cmds[3] = width - 1;
+  ssd->window_cmds[4] = SET_PAGE_ADDR;
+  ssd->window_cmds[5] = 0;
+  ssd->window_cmds[6] = ssd->pages - 1;
+
+  ssd->write = ssd1306_i2c_write;
+  ssd->write_ctx = i2c;
+  ssd->inverted = false;
+  ssd->scrolling = false;
+}
+
+// Troca o transporte de escrita (por exemplo, pelo gerenciador do barramento I2C)
+void ssd1306_set_transport(ssd1306_t *ssd, ssd1306_write_fn_t write, void *ctx) {
+  ssd->write = write;
+  ssd->write_ctx = ctx;
 }
 
+// Sequência de inicialização enviada em uma única transação
+static const uint8_t init_sequence[] = {
+  SET_DISP | 0x00,
+  SET_MEM_ADDR, 0x01,
+  SET_DISP_START_LINE | 0x00,
+  SET_SEG_REMAP | 0x01,
+  SET_MUX_RATIO, HEIGHT - 1,
+  SET_COM_OUT_DIR | 0x08,
+  SET_DISP_OFFSET, 0x00,
+  SET_COM_PIN_CFG, 0x12,
+  SET_DISP_CLK_DIV, 0x80,
+  SET_PRECHARGE, 0xF1,
+  SET_VCOM_DESEL, 0x30,
+  SET_CONTRAST, 0xFF,
+  SET_ENTIRE_ON,
+  SET_NORM_INV,
+  SET_CHARGE_PUMP, 0x14,
+  SET_DISP | 0x01
+};
+
 void ssd1306_config(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_DISP | 0x00);
-  ssd1306_command(ssd, SET_MEM_ADDR);
-  ssd1306_command(ssd, 0x01);
-  ssd1306_command(ssd, SET_DISP_START_LINE | 0x00);
-  ssd1306_command(ssd, SET_SEG_REMAP | 0x01);
-  ssd1306_command(ssd, SET_MUX_RATIO);
-  ssd1306_command(ssd, HEIGHT - 1);
-  ssd1306_command(ssd, SET_COM_OUT_DIR | 0x08);
-  ssd1306_command(ssd, SET_DISP_OFFSET);
-  ssd1306_command(ssd, 0x00);
-  ssd1306_command(ssd, SET_COM_PIN_CFG);
-  ssd1306_command(ssd, 0x12);
-  ssd1306_command(ssd, SET_DISP_CLK_DIV);
-  ssd1306_command(ssd, 0x80);
-  ssd1306_command(ssd, SET_PRECHARGE);
-  ssd1306_command(ssd, 0xF1);
-  ssd1306_command(ssd, SET_VCOM_DESEL);
-  ssd1306_command(ssd, 0x30);
-  ssd1306_command(ssd, SET_CONTRAST);
-  ssd1306_command(ssd, 0xFF);
-  ssd1306_command(ssd, SET_ENTIRE_ON);
-  ssd1306_command(ssd, SET_NORM_INV);
-  ssd1306_command(ssd, SET_CHARGE_PUMP);
-  ssd1306_command(ssd, 0x14);
-  ssd1306_command(ssd, SET_DISP | 0x01);
+  ssd1306_command_list(ssd, init_sequence, sizeof(init_sequence));
 }
 
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
   ssd->port_buffer[1] = command;
-  i2c_write_blocking(
-    ssd->i2c_port,
-    ssd->address,
-    ssd->port_buffer,
-    2,
-    false
-  );
+  ssd->write(ssd->write_ctx, ssd->address, ssd->port_buffer, 2);
+}
+
+// Envia uma sequência de comandos em uma transação: o byte de controle 0x00 (Co = 0,
+// D/C = 0) indica que todos os bytes seguintes são comandos
+void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *commands, size_t count) {
+  uint8_t buffer[SSD1306_COMMAND_LIST_MAX + 1];
+
+  while (count > 0) {
+    size_t n = count > SSD1306_COMMAND_LIST_MAX ? SSD1306_COMMAND_LIST_MAX : count;
+    buffer[0] = 0x00;
+    memcpy(&buffer[1], commands, n);
+    ssd->write(ssd->write_ctx, ssd->address, buffer, n + 1);
+    commands += n;
+    count -= n;
+  }
 }
 
 void ssd1306_send_data(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_COL_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->width - 1);
-  ssd1306_command(ssd, SET_PAGE_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->pages - 1);
-  i2c_write_blocking(
-    ssd->i2c_port,
-    ssd->address,
-    ssd->ram_buffer,
-    ssd->bufsize,
-    false
-  );
+  // A RAM não deve ser escrita com a rolagem horizontal ativa
+  if (ssd->scrolling) {
+    ssd1306_scroll_stop(ssd);
+  }
+
+  // Janela de endereçamento pré-calculada na inicialização + quadro
+  ssd->write(ssd->write_ctx, ssd->address, ssd->window_cmds, sizeof(ssd->window_cmds));
+  ssd->write(ssd->write_ctx, ssd->address, ssd->ram_buffer, ssd->bufsize);
+}
+
+// Desliga o painel (modo de repouso do controlador, a RAM é preservada) ou religa
+void ssd1306_set_power(ssd1306_t *ssd, bool on) {
+  ssd1306_command(ssd, SET_DISP | (on ? 0x01 : 0x00));
+}
+
+// O remapeamento de segmentos vale para as próximas escritas na RAM; a direção do
+// COM é imediata. Após trocar a orientação, reenvie o quadro com ssd1306_send_data.
+void ssd1306_set_orientation(ssd1306_t *ssd, ssd1306_orientation_t orientation) {
+  uint8_t seg = 0x01, com = 0x08;
+
+  switch (orientation) {
+    case SSD1306_ORIENTATION_ROTATE_180:
+      seg = 0x00;
+      com = 0x00;
+      break;
+    case SSD1306_ORIENTATION_MIRROR_X:
+      seg = 0x00;
+      break;
+    case SSD1306_ORIENTATION_MIRROR_Y:
+      com = 0x00;
+      break;
+    default:
+      break;
+  }
+
+  uint8_t commands[] = { SET_SEG_REMAP | seg, SET_COM_OUT_DIR | com };
+  ssd1306_command_list(ssd, commands, sizeof(commands));
+}
+
+// Linha da RAM exibida no topo (0-63): rolagem vertical sem reenviar o quadro
+void ssd1306_set_start_line(ssd1306_t *ssd, uint8_t line) {
+  ssd1306_command(ssd, SET_DISP_START_LINE | (line & 0x3F));
+}
+
+// Inversão de vídeo feita pelo controlador; só envia o comando quando o estado muda
+void ssd1306_invert(ssd1306_t *ssd, bool inverted) {
+  if (inverted == ssd->inverted) {
+    return;
+  }
+  ssd->inverted = inverted;
+  ssd1306_command(ssd, SET_NORM_INV | (inverted ? 0x01 : 0x00));
+}
+
+// Rolagem horizontal contínua das páginas start_page..end_page
+void ssd1306_scroll_horizontal(ssd1306_t *ssd, bool left, uint8_t start_page, uint8_t end_page,
+                               ssd1306_scroll_interval_t interval) {
+  uint8_t commands[] = {
+    SET_SCROLL_OFF,
+    left ? SET_HSCROLL_LEFT : SET_HSCROLL_RIGHT,
+    0x00, start_page & 0x07, interval, end_page & 0x07, 0x00, 0xFF,
+    SET_SCROLL_ON
+  };
+  ssd1306_command_list(ssd, commands, sizeof(commands));
+  ssd->scrolling = true;
+}
+
+void ssd1306_scroll_stop(ssd1306_t *ssd) {
+  ssd1306_command(ssd, SET_SCROLL_OFF);
+  ssd->scrolling = false;
 }
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
@@ -1,3 +1,6 @@
+#ifndef SSD1306_H
+#define SSD1306_H
+
 #include <stdlib.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
@@ -5,6 +8,12 @@
 #define WIDTH 128
 #define HEIGHT 64
 
+// Tamanho do buffer de quadro: byte de controle + uma página por coluna
+#define SSD1306_BUFFER_SIZE(width, height) ((size_t)((height) / 8U) * (width) + 1)
+
+// Maior sequência de comandos enviada em uma única transação
+#define SSD1306_COMMAND_LIST_MAX 32
+
 typedef enum {
   SET_CONTRAST = 0x81,
   SET_ENTIRE_ON = 0xA4,
@@ -22,9 +31,36 @@ typedef enum {
   SET_DISP_CLK_DIV = 0xD5,
   SET_PRECHARGE = 0xD9,
   SET_VCOM_DESEL = 0xDB,
-  SET_CHARGE_PUMP = 0x8D
+  SET_CHARGE_PUMP = 0x8D,
+  SET_HSCROLL_RIGHT = 0x26,
+  SET_HSCROLL_LEFT = 0x27,
+  SET_SCROLL_OFF = 0x2E,
+  SET_SCROLL_ON = 0x2F
 } ssd1306_command_t;
 
+// Orientações suportadas pelo controlador (remapeamento de segmentos e direção do COM)
+typedef enum {
+  SSD1306_ORIENTATION_NORMAL,     // Orientação da configuração padrão
+  SSD1306_ORIENTATION_ROTATE_180, // Display montado de cabeça para baixo
+  SSD1306_ORIENTATION_MIRROR_X,   // Espelhado na horizontal
+  SSD1306_ORIENTATION_MIRROR_Y    // Espelhado na vertical
+} ssd1306_orientation_t;
+
+// Intervalo entre passos da rolagem horizontal, em quadros do controlador
+typedef enum {
+  SSD1306_SCROLL_5_FRAMES = 0x00,
+  SSD1306_SCROLL_64_FRAMES = 0x01,
+  SSD1306_SCROLL_128_FRAMES = 0x02,
+  SSD1306_SCROLL_256_FRAMES = 0x03,
+  SSD1306_SCROLL_3_FRAMES = 0x04,
+  SSD1306_SCROLL_4_FRAMES = 0x05,
+  SSD1306_SCROLL_25_FRAMES = 0x06,
+  SSD1306_SCROLL_2_FRAMES = 0x07
+} ssd1306_scroll_interval_t;
+
+// Transporte de escrita: envia len bytes para o endereço I2C e devolve os bytes escritos
+typedef int (*ssd1306_write_fn_t)(void *ctx, uint8_t address, const uint8_t *src, size_t len);
+
 typedef struct {
   uint8_t width, height, pages, address;
   i2c_inst_t *i2c_port;
@@ -32,13 +68,30 @@ typedef struct {
   uint8_t *ram_buffer;
   size_t bufsize;
   uint8_t port_buffer[2];
+  uint8_t window_cmds[7];
+  ssd1306_write_fn_t write;
+  void *write_ctx;
+  bool inverted;
+  bool scrolling;
 } ssd1306_t;
 
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
+void ssd1306_init_with_buffer(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c, uint8_t *buffer);
+void ssd1306_set_transport(ssd1306_t *ssd, ssd1306_write_fn_t write, void *ctx);
 void ssd1306_config(ssd1306_t *ssd);
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
+void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *commands, size_t count);
 void ssd1306_send_data(ssd1306_t *ssd);
 
+// Efeitos feitos pelo próprio controlador, com poucos bytes de comando
+void ssd1306_set_power(ssd1306_t *ssd, bool on);
+void ssd1306_set_orientation(ssd1306_t *ssd, ssd1306_orientation_t orientation);
+void ssd1306_set_start_line(ssd1306_t *ssd, uint8_t line);
+void ssd1306_invert(ssd1306_t *ssd, bool inverted);
+void ssd1306_scroll_horizontal(ssd1306_t *ssd, bool left, uint8_t start_page, uint8_t end_page,
+                               ssd1306_scroll_interval_t interval);
+void ssd1306_scroll_stop(ssd1306_t *ssd);
+
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
 void ssd1306_fill(ssd1306_t *ssd, bool value);
 void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill);
@@ -46,4 +99,6 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value);
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value);
 void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y);
-void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
\ No newline at end of file
+void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
+
+#endif
@@ -0,0 +1,68 @@
+#include <stdio.h>
+#include "static_alloc.h"
+
+// Cria uma tarefa na memória fornecida (modo estático) ou no heap do FreeRTOS
+TaskHandle_t static_alloc_task(TaskFunction_t function, const char *name, uint32_t stack_words,
+                               UBaseType_t priority, StackType_t *stack, StaticTask_t *tcb) {
+#if HYDRO_STATIC_ALLOCATION
+    return xTaskCreateStatic(function, name, stack_words, NULL, priority, stack, tcb);
+#else
+    TaskHandle_t handle = NULL;
+    xTaskCreate(function, name, stack_words, NULL, priority, &handle);
+    return handle;
+#endif
+}
+
+// Cria uma fila na memória fornecida (modo estático) ou no heap do FreeRTOS
+QueueHandle_t static_alloc_queue(UBaseType_t length, UBaseType_t item_size,
+                                 uint8_t *storage, StaticQueue_t *queue) {
+#if HYDRO_STATIC_ALLOCATION
+    return xQueueCreateStatic(length, item_size, storage, queue);
+#else
+    return xQueueCreate(length, item_size);
+#endif
+}
+
+// Cria um mutex (com herança de prioridade) na memória fornecida ou no heap
+SemaphoreHandle_t static_alloc_mutex(StaticSemaphore_t *mutex) {
+#if HYDRO_STATIC_ALLOCATION
+    return xSemaphoreCreateMutexStatic(mutex);
+#else
+    return xSemaphoreCreateMutex();
+#endif
+}
+
+// Imprime o mapa de memória calculado em tempo de compilação
+void static_alloc_report(const memory_map_entry_t *entries, size_t count) {
+    size_t total = 0;
+
+    printf("MEM;modo=%s\n", HYDRO_STATIC_ALLOCATION ? "estatico" : "dinamico");
+    for (size_t i = 0; i < count; i++) {
+        printf("MEM;%s;%u\n", entries[i].name, (unsigned)entries[i].bytes);
+        total += entries[i].bytes;
+    }
+    printf("MEM;total;%u\n", (unsigned)total);
+#if configSUPPORT_DYNAMIC_ALLOCATION
+    printf("MEM;heap_livre;%u\n", (unsigned)xPortGetFreeHeapSize());
+#endif
+}
+
+#if HYDRO_STATIC_ALLOCATION
+// Memória das tarefas Idle e Timer exigida pelo FreeRTOS no modo estático
+static StackType_t idle_stack[configMINIMAL_STACK_SIZE] HYDRO_ARENA;
+static StaticTask_t idle_tcb HYDRO_ARENA;
+static StackType_t timer_stack[configTIMER_TASK_STACK_DEPTH] HYDRO_ARENA;
+static StaticTask_t timer_tcb HYDRO_ARENA;
+
+void vApplicationGetIdleTaskMemory(StaticTask_t **tcb, StackType_t **stack, uint32_t *stack_words) {
+    *tcb = &idle_tcb;
+    *stack = idle_stack;
+    *stack_words = configMINIMAL_STACK_SIZE;
+}
+
+void vApplicationGetTimerTaskMemory(StaticTask_t **tcb, StackType_t **stack, uint32_t *stack_words) {
+    *tcb = &timer_tcb;
+    *stack = timer_stack;
+    *stack_words = configTIMER_TASK_STACK_DEPTH;
+}
+#endif
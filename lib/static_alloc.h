@@ -0,0 +1,37 @@
+#ifndef STATIC_ALLOC_H
+#define STATIC_ALLOC_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+// Modo de alocação estática (definido pela opção HYDRO_STATIC_ALLOCATION do CMake)
+#ifndef HYDRO_STATIC_ALLOCATION
+#define HYDRO_STATIC_ALLOCATION 0
+#endif
+
+// Objetos estáticos ficam agrupados em uma seção própria, visível no mapa do linker
+#define HYDRO_ARENA __attribute__((section(".bss.hydro_arena"), aligned(8)))
+
+// Referência para memória estática que vira NULL no modo dinâmico
+#if HYDRO_STATIC_ALLOCATION
+#define STATIC_MEMORY(x) (x)
+#else
+#define STATIC_MEMORY(x) NULL
+#endif
+
+// Entrada do relatório de memória
+typedef struct {
+    const char *name;
+    size_t bytes;
+} memory_map_entry_t;
+
+TaskHandle_t static_alloc_task(TaskFunction_t function, const char *name, uint32_t stack_words,
+                               UBaseType_t priority, StackType_t *stack, StaticTask_t *tcb);
+QueueHandle_t static_alloc_queue(UBaseType_t length, UBaseType_t item_size,
+                                 uint8_t *storage, StaticQueue_t *queue);
+SemaphoreHandle_t static_alloc_mutex(StaticSemaphore_t *mutex);
+void static_alloc_report(const memory_map_entry_t *entries, size_t count);
+
+#endif
@@ -0,0 +1,97 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/watchdog.h"
+#include "supervisor.h"
+#include "rt_monitor.h"
+
+typedef struct {
+    TaskHandle_t task;
+    const char *name;
+    uint32_t timeout_ms;
+    volatile TickType_t last_beat;
+    uint32_t max_age_ms;
+} watched_task_t;
+
+static watched_task_t watched[SUPERVISOR_MAX_TASKS];
+static uint8_t watched_count = 0;
+static supervisor_fault_fn_t fault_hook = NULL;
+
+// Registra uma tarefa; o prazo conta a partir do registro
+bool supervisor_watch(TaskHandle_t task, const char *name, uint32_t timeout_ms) {
+    if (watched_count >= SUPERVISOR_MAX_TASKS || task == NULL || timeout_ms == 0) {
+        return false;
+    }
+    watched[watched_count].task = task;
+    watched[watched_count].name = name;
+    watched[watched_count].timeout_ms = timeout_ms;
+    watched[watched_count].last_beat = xTaskGetTickCount();
+    watched[watched_count].max_age_ms = 0;
+    watched_count++;
+    return true;
+}
+
+void supervisor_set_fault_hook(supervisor_fault_fn_t hook) {
+    fault_hook = hook;
+}
+
+void supervisor_beat(void) {
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    for (uint8_t i = 0; i < watched_count; i++) {
+        if (watched[i].task == self) {
+            watched[i].last_beat = xTaskGetTickCount();
+            return;
+        }
+    }
+}
+
+static uint32_t age_ms(const watched_task_t *entry, TickType_t now) {
+    return (uint32_t)(now - entry->last_beat) * portTICK_PERIOD_MS;
+}
+
+void vSupervisorTask(void *params) {
+    bool failed = false;
+
+    watchdog_enable(SUPERVISOR_WATCHDOG_MS, true);
+    while (true) {
+        TickType_t now = xTaskGetTickCount();
+        const char *culprit = NULL;
+
+        for (uint8_t i = 0; i < watched_count; i++) {
+            uint32_t age = age_ms(&watched[i], now);
+            if (age > watched[i].max_age_ms) {
+                watched[i].max_age_ms = age;
+            }
+            if (age > watched[i].timeout_ms && culprit == NULL) {
+                culprit = watched[i].name;
+            }
+        }
+
+        // Sem alimentação o hardware reinicia; o gancho registra a causa antes disso
+        if (culprit == NULL) {
+            watchdog_update();
+        } else if (!failed) {
+            failed = true;
+            printf("SUP;falha;%s\n", culprit);
+            if (fault_hook != NULL) {
+                fault_hook(culprit);
+            }
+        }
+        // Período fixo a partir da liberação (vTaskDelay se a tarefa não estiver no monitor)
+        rt_monitor_wait_ms(SUPERVISOR_PERIOD_MS);
+    }
+}
+
+uint8_t supervisor_count(void) {
+    return watched_count;
+}
+
+bool supervisor_get(uint8_t index, supervisor_entry_t *entry) {
+    if (index >= watched_count) {
+        return false;
+    }
+    entry->name = watched[index].name;
+    entry->timeout_ms = watched[index].timeout_ms;
+    entry->age_ms = age_ms(&watched[index], xTaskGetTickCount());
+    entry->max_age_ms = watched[index].max_age_ms;
+    return true;
+}
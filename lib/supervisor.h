@@ -0,0 +1,40 @@
+#ifndef SUPERVISOR_H
+#define SUPERVISOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Supervisor de tarefas: cada tarefa monitorada sinaliza (supervisor_beat) a cada volta
+// do seu laço, e o watchdog do RP2040 só é alimentado enquanto todas sinalizaram dentro
+// do próprio prazo. Uma tarefa travada (barramento preso, laço infinito) leva ao
+// reinício pelo hardware em até SUPERVISOR_WATCHDOG_MS.
+#define SUPERVISOR_MAX_TASKS 10
+#define SUPERVISOR_PERIOD_MS 250           // Intervalo de verificação
+#define SUPERVISOR_WATCHDOG_MS 2000        // Prazo do watchdog após a última alimentação
+
+// Chamado uma vez, antes de parar de alimentar o watchdog, com a tarefa que falhou
+typedef void (*supervisor_fault_fn_t)(const char *task_name);
+
+// Estado de uma tarefa monitorada
+typedef struct {
+    const char *name;
+    uint32_t timeout_ms;       // Prazo máximo entre sinais
+    uint32_t age_ms;           // Tempo desde o último sinal
+    uint32_t max_age_ms;       // Maior intervalo observado entre sinais
+} supervisor_entry_t;
+
+bool supervisor_watch(TaskHandle_t task, const char *name, uint32_t timeout_ms);
+void supervisor_set_fault_hook(supervisor_fault_fn_t hook);
+
+// Sinal de vida da tarefa chamadora (sem efeito se ela não for monitorada)
+void supervisor_beat(void);
+
+// Tarefa do supervisor: deve ter a maior prioridade do sistema
+void vSupervisorTask(void *params);
+
+uint8_t supervisor_count(void);
+bool supervisor_get(uint8_t index, supervisor_entry_t *entry);
+
+#endif
@@ -0,0 +1,101 @@
+#include "telemetry_frame.h"
+#include "warm_state.h"
+
+static int16_t to_fixed(float value, float scale) {
+    float scaled = value * scale;
+    if (scaled > INT16_MAX) {
+        return INT16_MAX;
+    }
+    if (scaled < INT16_MIN) {
+        return INT16_MIN;
+    }
+    return (int16_t)(scaled >= 0.0f ? scaled + 0.5f : scaled - 0.5f);
+}
+
+static uint8_t *put_u16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    return p + 2;
+}
+
+static uint8_t *put_u32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+    return p + 4;
+}
+
+static uint16_t get_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | p[1] << 8);
+}
+
+static uint32_t get_u32(const uint8_t *p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+void telemetry_frame_from_sample(telemetry_frame_t *frame, const sensor_data_t *data,
+                                 uint16_t station, uint16_t sequence) {
+    uint8_t count = data->channel_count < TELEMETRY_FRAME_MAX_CHANNELS ? data->channel_count
+                                                                       : TELEMETRY_FRAME_MAX_CHANNELS;
+
+    frame->station = station;
+    frame->sequence = sequence;
+    frame->timestamp_ms = data->timestamp;
+    frame->mode = (uint8_t)data->mode;
+    frame->flags = (data->pre_alert ? TELEMETRY_FLAG_PRE_ALERT : 0) |
+                   (data->trend_worsening ? TELEMETRY_FLAG_WORSENING : 0);
+    frame->time_to_critical = data->time_to_critical;
+    frame->channel_count = count;
+    for (int i = 0; i < count; i++) {
+        frame->value[i] = to_fixed(data->value[i], 10.0f);
+        frame->rate[i] = to_fixed(data->rate[i], 100.0f);
+    }
+}
+
+size_t telemetry_frame_encode(const telemetry_frame_t *frame, uint8_t *buffer) {
+    uint8_t *p = buffer;
+
+    *p++ = TELEMETRY_FRAME_SYNC;
+    *p++ = TELEMETRY_FRAME_VERSION;
+    p = put_u16(p, frame->station);
+    p = put_u16(p, frame->sequence);
+    p = put_u32(p, frame->timestamp_ms);
+    *p++ = frame->mode;
+    *p++ = frame->flags;
+    p = put_u32(p, (uint32_t)frame->time_to_critical);
+    *p++ = frame->channel_count;
+    for (int i = 0; i < frame->channel_count; i++) {
+        p = put_u16(p, (uint16_t)frame->value[i]);
+        p = put_u16(p, (uint16_t)frame->rate[i]);
+    }
+    p = put_u32(p, warm_state_crc32(buffer, (size_t)(p - buffer)));
+    return (size_t)(p - buffer);
+}
+
+size_t telemetry_frame_decode(const uint8_t *buffer, size_t length, telemetry_frame_t *frame) {
+    if (length < TELEMETRY_FRAME_HEADER || buffer[0] != TELEMETRY_FRAME_SYNC ||
+        buffer[1] != TELEMETRY_FRAME_VERSION || buffer[10] > CRITICAL_MODE ||
+        buffer[16] > TELEMETRY_FRAME_MAX_CHANNELS) {
+        return 0;
+    }
+
+    uint8_t count = buffer[16];
+    size_t size = TELEMETRY_FRAME_SIZE(count);
+    if (length < size || get_u32(buffer + size - 4) != warm_state_crc32(buffer, size - 4)) {
+        return 0;
+    }
+
+    frame->station = get_u16(buffer + 2);
+    frame->sequence = get_u16(buffer + 4);
+    frame->timestamp_ms = get_u32(buffer + 6);
+    frame->mode = buffer[10];
+    frame->flags = buffer[11];
+    frame->time_to_critical = (int32_t)get_u32(buffer + 12);
+    frame->channel_count = count;
+    for (int i = 0; i < count; i++) {
+        frame->value[i] = (int16_t)get_u16(buffer + TELEMETRY_FRAME_HEADER + 4 * i);
+        frame->rate[i] = (int16_t)get_u16(buffer + TELEMETRY_FRAME_HEADER + 4 * i + 2);
+    }
+    return size;
+}
@@ -0,0 +1,48 @@
+#ifndef TELEMETRY_FRAME_H
+#define TELEMETRY_FRAME_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "sensor_data.h"
+
+// Quadro binário de telemetria de uma estação, little-endian:
+//   sync(1) versão(1) estação(2) sequência(2) tempo_ms(4) modo(1) flags(1) t_critico_s(4)
+//   canais(1) { valor ×10 (int16) taxa ×100 (int16) } × canais  crc32(4)
+// O CRC32 (o mesmo do bloco de reinício a quente) cobre tudo antes dele. Com dois
+// canais o quadro tem 29 bytes, contra ~50 da linha TLM em texto.
+#define TELEMETRY_FRAME_SYNC 0xA5
+#define TELEMETRY_FRAME_VERSION 1
+#define TELEMETRY_FRAME_MAX_CHANNELS 8
+#define TELEMETRY_FRAME_HEADER 17
+#define TELEMETRY_FRAME_SIZE(channels) (TELEMETRY_FRAME_HEADER + 4 * (channels) + 4)
+#define TELEMETRY_FRAME_MAX TELEMETRY_FRAME_SIZE(TELEMETRY_FRAME_MAX_CHANNELS)
+
+#define TELEMETRY_FLAG_PRE_ALERT (1u << 0)
+#define TELEMETRY_FLAG_WORSENING (1u << 1)
+
+typedef struct {
+    uint16_t station;
+    uint16_t sequence;
+    uint32_t timestamp_ms;
+    uint8_t mode;              // SystemMode
+    uint8_t flags;
+    int32_t time_to_critical;  // s (-1 = sem previsão)
+    uint8_t channel_count;
+    int16_t value[TELEMETRY_FRAME_MAX_CHANNELS];   // Décimos da unidade do canal
+    int16_t rate[TELEMETRY_FRAME_MAX_CHANNELS];    // Centésimos da unidade/min
+} telemetry_frame_t;
+
+// Preenche o quadro a partir do bloco de amostras (canais além do limite são omitidos)
+void telemetry_frame_from_sample(telemetry_frame_t *frame, const sensor_data_t *data,
+                                 uint16_t station, uint16_t sequence);
+
+// Serializa em buffer (pelo menos TELEMETRY_FRAME_MAX bytes); devolve o tamanho
+size_t telemetry_frame_encode(const telemetry_frame_t *frame, uint8_t *buffer);
+
+// Lê um quadro do início de buffer; devolve os bytes consumidos ou 0 se o quadro
+// está incompleto, com sync ou versão inválidos, com CRC errado ou com modo ou número
+// de canais fora dos limites (o CRC não garante que o conteúdo veio de uma estação)
+size_t telemetry_frame_decode(const uint8_t *buffer, size_t length, telemetry_frame_t *frame);
+
+#endif
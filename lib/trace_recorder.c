@@ -0,0 +1,119 @@
+#include "FreeRTOS.h"
+
+#if HYDRO_TRACE
+
+#include <stdio.h>
+#include "task.h"
+#include "queue.h"
+#include "pico/stdlib.h"
+#include "trace_recorder.h"
+
+// Anel de eventos; o índice de escrita só avança com interrupções desabilitadas
+static trace_event_t buffer[TRACE_BUFFER_EVENTS];
+static uint32_t head = 0;
+static volatile bool recording = true;
+static volatile uint8_t block_queue = TRACE_BLOCK_ALL_QUEUES;
+static const char *queue_names[TRACE_MAX_QUEUES + 1];
+
+// Numera a fila para o trace (filas sem número, como mutexes internos, são ignoradas)
+void trace_register_queue(void *queue, uint8_t number, const char *name) {
+    if (number == 0 || number > TRACE_MAX_QUEUES) {
+        return;
+    }
+    vQueueSetQueueNumber((QueueHandle_t)queue, number);
+    queue_names[number] = name;
+}
+
+static inline void trace_record(uint8_t event, uint8_t id, uint16_t arg) {
+    if (!recording) {
+        return;
+    }
+
+    uint32_t status = save_and_disable_interrupts();
+    trace_event_t *slot = &buffer[head % TRACE_BUFFER_EVENTS];
+    head++;
+    slot->timestamp_us = time_us_32();
+    slot->event = event;
+    slot->id = id;
+    slot->arg = arg;
+    restore_interrupts(status);
+}
+
+// Chamado pelo kernel na troca de contexto (traceTASK_SWITCHED_IN)
+void trace_task_switched_in(void) {
+    trace_record(TRACE_EVT_TASK_SWITCH_IN, (uint8_t)uxTaskGetTaskNumber(xTaskGetCurrentTaskHandle()), 0);
+}
+
+// Chamado pelo kernel nas operações de fila; apenas filas numeradas são gravadas,
+// e bloqueios só na fila escolhida (ou em todas)
+void trace_queue_event(uint8_t event, void *queue) {
+    QueueHandle_t handle = (QueueHandle_t)queue;
+    uint8_t number = (uint8_t)uxQueueGetQueueNumber(handle);
+    if (number == 0) {
+        return;
+    }
+
+    if (event == TRACE_EVT_QUEUE_BLOCK_RECEIVE || event == TRACE_EVT_QUEUE_BLOCK_SEND) {
+        if (block_queue != TRACE_BLOCK_ALL_QUEUES && block_queue != number) {
+            return;
+        }
+        trace_record(event, number, (uint16_t)uxTaskGetTaskNumber(xTaskGetCurrentTaskHandle()));
+    } else {
+        trace_record(event, number, (uint16_t)uxQueueMessagesWaitingFromISR(handle));
+    }
+}
+
+void trace_start(void) {
+    uint32_t status = save_and_disable_interrupts();
+    head = 0;
+    restore_interrupts(status);
+    recording = true;
+}
+
+void trace_stop(void) {
+    recording = false;
+}
+
+void trace_set_block_queue(uint8_t queue_number) {
+    block_queue = queue_number;
+}
+
+// Envia o conteúdo do anel pela saída padrão
+// Formato: TRC;inicio;eventos;descartados / TRC;tarefa;numero;nome / TRC;fila;numero;nome /
+//          TRC;e;<hex de até 16 eventos de 8 bytes> / TRC;fim
+void trace_dump(void) {
+    static TaskStatus_t status[12];
+    bool was_recording = recording;
+    recording = false;
+
+    uint32_t total = head;
+    uint32_t count = total < TRACE_BUFFER_EVENTS ? total : TRACE_BUFFER_EVENTS;
+    uint32_t first = total - count;
+    printf("TRC;inicio;%lu;%lu\n", (unsigned long)count, (unsigned long)first);
+
+    UBaseType_t tasks = uxTaskGetSystemState(status, count_of(status), NULL);
+    for (UBaseType_t i = 0; i < tasks; i++) {
+        printf("TRC;tarefa;%lu;%s\n", (unsigned long)uxTaskGetTaskNumber(status[i].xHandle), status[i].pcTaskName);
+    }
+
+    for (int i = 1; i <= TRACE_MAX_QUEUES; i++) {
+        if (queue_names[i] != NULL) {
+            printf("TRC;fila;%d;%s\n", i, queue_names[i]);
+        }
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (i % 16 == 0) {
+            printf(i == 0 ? "TRC;e;" : "\nTRC;e;");
+        }
+        const uint8_t *bytes = (const uint8_t *)&buffer[(first + i) % TRACE_BUFFER_EVENTS];
+        for (unsigned b = 0; b < sizeof(trace_event_t); b++) {
+            printf("%02x", bytes[b]);
+        }
+    }
+    printf("%sTRC;fim\n", count > 0 ? "\n" : "");
+
+    recording = was_recording;
+}
+
+#endif
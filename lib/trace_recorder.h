@@ -0,0 +1,48 @@
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+// Gravador de eventos do kernel em anel na RAM (opção HYDRO_TRACE do CMake).
+// Este cabeçalho é incluído ao final do FreeRTOSConfig.h e define as macros de trace.
+
+#include <stdint.h>
+
+// Capacidade do anel (eventos de 8 bytes)
+#define TRACE_BUFFER_EVENTS 2048
+
+// Tipos de evento
+#define TRACE_EVT_TASK_SWITCH_IN 1      // id = número da tarefa
+#define TRACE_EVT_QUEUE_SEND 2          // id = número da fila, arg = mensagens antes do envio
+#define TRACE_EVT_QUEUE_SEND_FAILED 3   // id = número da fila, arg = mensagens na fila
+#define TRACE_EVT_QUEUE_RECEIVE 4       // id = número da fila, arg = mensagens antes da leitura
+#define TRACE_EVT_QUEUE_BLOCK_RECEIVE 5 // id = número da fila, arg = tarefa bloqueada
+#define TRACE_EVT_QUEUE_BLOCK_SEND 6    // id = número da fila, arg = tarefa bloqueada
+
+// Filas numeradas (1..TRACE_MAX_QUEUES) que aparecem no trace
+#define TRACE_MAX_QUEUES 8
+
+// Valor de trace_block_queue que registra bloqueios em todas as filas numeradas
+#define TRACE_BLOCK_ALL_QUEUES 0xFF
+
+typedef struct {
+    uint32_t timestamp_us;
+    uint8_t event;
+    uint8_t id;
+    uint16_t arg;
+} trace_event_t;
+
+void trace_register_queue(void *queue, uint8_t number, const char *name);
+void trace_task_switched_in(void);
+void trace_queue_event(uint8_t event, void *queue);
+void trace_start(void);
+void trace_stop(void);
+void trace_set_block_queue(uint8_t queue_number);
+void trace_dump(void);
+
+#define traceTASK_SWITCHED_IN() trace_task_switched_in()
+#define traceQUEUE_SEND(pxQueue) trace_queue_event(TRACE_EVT_QUEUE_SEND, (void *)(pxQueue))
+#define traceQUEUE_SEND_FAILED(pxQueue) trace_queue_event(TRACE_EVT_QUEUE_SEND_FAILED, (void *)(pxQueue))
+#define traceQUEUE_RECEIVE(pxQueue) trace_queue_event(TRACE_EVT_QUEUE_RECEIVE, (void *)(pxQueue))
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue) trace_queue_event(TRACE_EVT_QUEUE_BLOCK_RECEIVE, (void *)(pxQueue))
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue) trace_queue_event(TRACE_EVT_QUEUE_BLOCK_SEND, (void *)(pxQueue))
+
+#endif
@@ -0,0 +1,30 @@
+#include "warm_state.h"
+
+// CRC32 (polinômio refletido 0xEDB88320) com tabela de 16 entradas: um passo por nibble
+uint32_t warm_state_crc32(const void *data, size_t length) {
+    static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+    };
+    const uint8_t *bytes = data;
+    uint32_t crc = 0xFFFFFFFFu;
+
+    for (size_t i = 0; i < length; i++) {
+        crc ^= bytes[i];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+void warm_state_seal(warm_header_t *header, uint32_t magic, size_t length) {
+    header->magic = magic;
+    header->length = (uint32_t)length;
+    header->sequence++;
+    header->crc = warm_state_crc32(header + 1, length - sizeof(*header));
+}
+
+bool warm_state_valid(const warm_header_t *header, uint32_t magic, size_t length) {
+    return header->magic == magic && header->length == length &&
+           header->crc == warm_state_crc32(header + 1, length - sizeof(*header));
+}
@@ -0,0 +1,28 @@
+#ifndef WARM_STATE_H
+#define WARM_STATE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Bloco de estado preservado em reinício a quente. Fica na RAM não inicializada pelo
+// runtime (seção .uninitialized_data) e sobrevive ao reinício pelo watchdog ou por
+// software, mas não à perda de alimentação. O cabeçalho identifica a versão do layout
+// e um CRC32 cobre o restante do bloco, então um bloco de lixo após ligar a placa ou
+// gravado pela metade é descartado.
+typedef struct {
+    uint32_t magic;            // Identifica a aplicação e a versão do layout
+    uint32_t length;           // Tamanho total do bloco, com o cabeçalho
+    uint32_t sequence;         // Número de gravações desde a última partida a frio
+    uint32_t crc;              // CRC32 dos bytes após o cabeçalho
+} warm_header_t;
+
+uint32_t warm_state_crc32(const void *data, size_t length);
+
+// Atualiza a sequência e o CRC do bloco que começa pelo cabeçalho
+void warm_state_seal(warm_header_t *header, uint32_t magic, size_t length);
+
+// Verifica magic, tamanho e CRC
+bool warm_state_valid(const warm_header_t *header, uint32_t magic, size_t length);
+
+#endif
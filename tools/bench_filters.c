@@ -0,0 +1,192 @@
+// Benchmark no host: custo por amostra de cada estágio de filtro (mediana móvel e
+// detector de Hampel) e do canal completo (filtro, tendência e classificação), além
+// da qualidade da rejeição em um sinal com picos isolados e um degrau real.
+//
+// Compilação (a partir da raiz do projeto):
+//   gcc -O2 -Ilib tools/bench_filters.c lib/sensor_filter.c lib/sensor_channel.c lib/prediction.c -lm -o bench_filters
+//
+// Saída: uma linha JSON por caso. ns_per_op é o melhor de BENCH_REPEATS rodadas;
+// cycles_per_op usa o contador de ciclos do host (x86) e vale -1 nas demais arquiteturas.
+// O orçamento no RP2040 é da ordem de cycles_per_op × (razão de IPC): compare entre commits.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sensor_filter.h"
+#include "sensor_channel.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_CYCLES 1
+#endif
+
+#define BENCH_REPEATS 5
+#define BENCH_SAMPLES 2000000
+#define SIGNAL_LENGTH 4096
+
+static float signal[SIGNAL_LENGTH];
+static volatile float sink;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint64_t cycles(void) {
+#ifdef HAVE_CYCLES
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+// Ciclos médios por operação, ou -1 sem contador de ciclos
+static double cycles_per_op(uint64_t elapsed, uint32_t ops) {
+#ifdef HAVE_CYCLES
+    return (double)elapsed / ops;
+#else
+    (void)elapsed;
+    (void)ops;
+    return -1.0;
+#endif
+}
+
+// Nível com ruído de ±1% e picos isolados de +60% a cada ~200 amostras
+static void init_signal(void) {
+    srand(1);
+    for (int i = 0; i < SIGNAL_LENGTH; i++) {
+        signal[i] = 40.0f + (rand() % 200) / 100.0f - 1.0f;
+        if (rand() % 200 == 0) {
+            signal[i] += 60.0f;
+        }
+    }
+}
+
+// Referência ingênua: copia e ordena a janela a cada amostra (O(n log n))
+typedef struct {
+    float data[FILTER_WINDOW_MAX];
+    int window, count, next;
+} naive_median_t;
+
+static int cmp_float(const void *a, const void *b) {
+    float x = *(const float *)a, y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+static float naive_median_apply(void *state, float value) {
+    naive_median_t *m = state;
+    float sorted[FILTER_WINDOW_MAX];
+    m->data[m->next] = value;
+    m->next = (m->next + 1) % m->window;
+    if (m->count < m->window) {
+        m->count++;
+    }
+    memcpy(sorted, m->data, m->count * sizeof(float));
+    qsort(sorted, m->count, sizeof(float), cmp_float);
+    return (m->count & 1) ? sorted[m->count / 2] : 0.5f * (sorted[m->count / 2 - 1] + sorted[m->count / 2]);
+}
+
+typedef float (*stage_fn_t)(void *state, float value);
+
+static void report_stage(const char *name, int window, stage_fn_t fn, void *state) {
+    double best_ns = 0.0;
+    double best_cycles = 0.0;
+
+    for (int r = 0; r < BENCH_REPEATS; r++) {
+        double start = now_s();
+        uint64_t c0 = cycles();
+        for (int n = 0; n < BENCH_SAMPLES; n++) {
+            sink = fn(state, signal[n & (SIGNAL_LENGTH - 1)]);
+        }
+        uint64_t c1 = cycles();
+        double ns = (now_s() - start) * 1e9 / BENCH_SAMPLES;
+        double cy = cycles_per_op(c1 - c0, BENCH_SAMPLES);
+        if (r == 0 || ns < best_ns) {
+            best_ns = ns;
+            best_cycles = cy;
+        }
+    }
+    printf("{\"bench\":\"filters\",\"case\":\"%s\",\"window\":%d,\"ns_per_op\":%.1f,\"cycles_per_op\":%.0f}\n",
+           name, window, best_ns, best_cycles);
+}
+
+// Canal completo com leitura sintética
+static uint32_t signal_index;
+
+static float read_signal(void *ctx) {
+    (void)ctx;
+    return signal[signal_index++ & (SIGNAL_LENGTH - 1)];
+}
+
+static void report_channel(void) {
+    static hampel_filter_t filter;
+    sensor_data_t data;
+
+    hampel_filter_init(&filter, 7, 3.0f, 2.0f);
+    int ch = sensor_channel_register(&(sensor_channel_t){
+        .name = "nivel", .read = read_signal, .period_ms = 1,
+        .warning = 50.0f, .alert = 70.0f, .critical = 85.0f, .worsening_rate = 2.0f,
+    });
+    sensor_channel_add_filter(ch, hampel_filter_apply, &filter);
+
+    uint32_t samples = BENCH_SAMPLES / 4;
+    double start = now_s();
+    uint64_t c0 = cycles();
+    for (uint32_t t = 0; t < samples; t++) {
+        sensor_channels_sample(&data, t);
+    }
+    uint64_t c1 = cycles();
+    printf("{\"bench\":\"filters\",\"case\":\"channel_hampel\",\"window\":7,\"ns_per_op\":%.1f,"
+           "\"cycles_per_op\":%.0f}\n", (now_s() - start) * 1e9 / samples, cycles_per_op(c1 - c0, samples));
+}
+
+// Qualidade: picos isolados rejeitados, modos espúrios e atraso de um degrau real até 90%
+static void report_quality(int window) {
+    hampel_filter_t filter;
+    int spikes = 0, passed = 0, false_critical = 0, step_delay = -1;
+
+    hampel_filter_init(&filter, (uint8_t)window, 3.0f, 2.0f);
+    for (int i = 0; i < SIGNAL_LENGTH; i++) {
+        float out = hampel_filter_apply(&filter, signal[i]);
+        if (signal[i] > 80.0f) {
+            spikes++;
+            passed += out > 80.0f;
+        }
+        false_critical += out >= 85.0f;
+    }
+    for (int i = 0; i < 2 * FILTER_WINDOW_MAX; i++) {
+        if (hampel_filter_apply(&filter, 90.0f) >= 85.0f) {
+            step_delay = i;
+            break;
+        }
+    }
+    printf("{\"bench\":\"filters\",\"case\":\"hampel_quality\",\"window\":%d,\"spikes\":%d,\"spikes_passed\":%d,"
+           "\"false_critical\":%d,\"rejected\":%u,\"step_delay_samples\":%d}\n",
+           window, spikes, passed, false_critical, filter.rejected, step_delay);
+}
+
+int main(void) {
+    static median_filter_t median;
+    static hampel_filter_t hampel;
+    static naive_median_t naive;
+
+    init_signal();
+
+    static const int windows[] = { 5, 7, 15 };
+    for (size_t i = 0; i < sizeof(windows) / sizeof(windows[0]); i++) {
+        int w = windows[i];
+        median_filter_init(&median, (uint8_t)w);
+        report_stage("median", w, median_filter_apply, &median);
+        hampel_filter_init(&hampel, (uint8_t)w, 3.0f, 2.0f);
+        report_stage("hampel", w, hampel_filter_apply, &hampel);
+        memset(&naive, 0, sizeof(naive));
+        naive.window = w;
+        report_stage("median_qsort", w, naive_median_apply, &naive);
+    }
+    report_channel();
+    report_quality(7);
+    report_quality(15);
+
+    return sink == -1.0f;
+}
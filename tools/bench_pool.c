@@ -0,0 +1,212 @@
+// Benchmark no host: pipeline de amostras por cópia (filas com sensor_data_t)
+// versus pool de blocos com referências (filas com sample_ref_t).
+//
+// As filas imitam o xQueueSend/xQueueReceive do FreeRTOS: chamada fora de linha,
+// cópia do item inteiro por memcpy dentro de uma seção crítica. A mesma seção
+// crítica modelada é usada pelo pool (SAMPLE_POOL_HOST liga POOL_LOCK a ela), então
+// os dois caminhos pagam o mesmo custo por entrada. No host esse custo é só o de
+// uma chamada e um contador; no RP2040 ainda há o cpsid/cpsie. Por isso a saída traz,
+// além do tempo medido, as contagens exatas de bytes copiados e de seções críticas
+// por amostra, que não dependem da máquina.
+//
+// Compilação (a partir da raiz do projeto):
+//   gcc -O2 -DSAMPLE_POOL_HOST -Ilib tools/bench_pool.c lib/sample_pool.c -o bench_pool
+//
+// Saída: uma linha JSON com o tempo por amostra medido em cada caminho e as contagens.
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "sensor_data.h"
+#include "sample_pool.h"
+
+#define BENCH_SAMPLES 2000000
+#define BENCH_ROUNDS 5             // Vale a menor das rodadas de cada caminho
+
+// Modelo do taskENTER_CRITICAL/taskEXIT_CRITICAL do port (contador de aninhamento)
+static volatile uint32_t critical_nesting;
+static uint64_t critical_sections;
+static uint64_t bytes_copied;
+
+__attribute__((noinline)) void sample_pool_host_lock(void) {
+    critical_nesting++;
+    critical_sections++;
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+}
+
+__attribute__((noinline)) void sample_pool_host_unlock(void) {
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+    critical_nesting--;
+}
+
+// Fila com cópia por valor, como a fila do FreeRTOS
+typedef struct {
+    uint8_t storage[8 * sizeof(sensor_data_t)];
+    size_t item_size;
+    unsigned length, head, count;
+} host_queue_t;
+
+static void queue_init(host_queue_t *q, size_t item_size, unsigned length) {
+    q->item_size = item_size;
+    q->length = length;
+    q->head = 0;
+    q->count = 0;
+}
+
+__attribute__((noinline)) static int queue_send(host_queue_t *q, const void *item) {
+    int sent = 0;
+
+    sample_pool_host_lock();
+    if (q->count < q->length) {
+        memcpy(&q->storage[((q->head + q->count) % q->length) * q->item_size], item, q->item_size);
+        q->count++;
+        bytes_copied += q->item_size;
+        sent = 1;
+    }
+    sample_pool_host_unlock();
+    return sent;
+}
+
+__attribute__((noinline)) static int queue_receive(host_queue_t *q, void *item) {
+    int received = 0;
+
+    sample_pool_host_lock();
+    if (q->count > 0) {
+        memcpy(item, &q->storage[q->head * q->item_size], q->item_size);
+        q->head = (q->head + 1) % q->length;
+        q->count--;
+        bytes_copied += q->item_size;
+        received = 1;
+    }
+    sample_pool_host_unlock();
+    return received;
+}
+
+// Cópia da amostra para a variável global, como o last_sensor_data do caminho original
+__attribute__((noinline)) static void copy_sample(sensor_data_t *dst, const sensor_data_t *src) {
+    memcpy(dst, src, sizeof(*dst));
+    bytes_copied += sizeof(*dst);
+}
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Preenchimento equivalente ao de sensor_channels_sample
+static void fill_sample(sensor_data_t *data, uint32_t n) {
+    data->channel_count = SENSOR_MAX_CHANNELS;
+    for (int i = 0; i < SENSOR_MAX_CHANNELS; i++) {
+        data->value[i] = (float)((n + i) % 100);
+        data->rate[i] = 0.5f;
+        data->channel_ttc[i] = -1;
+        data->channel_mode[i] = NORMAL_MODE;
+    }
+    data->mode = (SystemMode)(n % 4);
+    data->timestamp = n;
+}
+
+static volatile uint32_t sink;
+
+typedef struct {
+    double ns_per_sample;
+    double bytes_per_sample;
+    double critical_per_sample;
+} bench_result_t;
+
+// Caminho original: sensor -> fila -> cópia global -> fila do display / fila de alertas
+static double run_copy(void) {
+    static host_queue_t sensor_q, display_q, alert_q;
+    static sensor_data_t produced, processed, last, displayed;
+    alert_control_t alert, received_alert;
+
+    queue_init(&sensor_q, sizeof(sensor_data_t), 5);
+    queue_init(&display_q, sizeof(sensor_data_t), 3);
+    queue_init(&alert_q, sizeof(alert_control_t), 5);
+
+    double start = now_s();
+    for (uint32_t n = 0; n < BENCH_SAMPLES; n++) {
+        fill_sample(&produced, n);
+        queue_send(&sensor_q, &produced);
+
+        queue_receive(&sensor_q, &processed);
+        copy_sample(&last, &processed);
+        alert.mode = processed.mode;
+        alert.update_display = alert.update_matrix = alert.update_sound = true;
+        queue_send(&display_q, &processed);
+        queue_send(&alert_q, &alert);
+
+        queue_receive(&display_q, &displayed);
+        queue_receive(&alert_q, &received_alert);
+        sink += displayed.timestamp + received_alert.mode + last.mode;
+    }
+    return now_s() - start;
+}
+
+// Caminho com pool: os blocos são preenchidos no lugar e as filas levam referências
+static double run_pool(void) {
+    static host_queue_t sensor_q, display_q, alert_q;
+    sample_ref_t ref, received;
+
+    sample_pool_init();
+    queue_init(&sensor_q, sizeof(sample_ref_t), 5);
+    queue_init(&display_q, sizeof(sample_ref_t), 3);
+    queue_init(&alert_q, sizeof(sample_ref_t), 5);
+
+    double start = now_s();
+    for (uint32_t n = 0; n < BENCH_SAMPLES; n++) {
+        ref = sample_pool_alloc();
+        fill_sample(sample_pool_get(ref), n);
+        queue_send(&sensor_q, &ref);
+
+        queue_receive(&sensor_q, &received);
+        sensor_data_t *data = sample_pool_get(received);
+        data->alert.mode = data->mode;
+        data->alert.update_display = data->alert.update_matrix = data->alert.update_sound = true;
+        sample_pool_publish(received);
+        sample_pool_retain(received);
+        queue_send(&display_q, &received);
+        sample_pool_retain(received);
+        queue_send(&alert_q, &received);
+        sample_pool_release(received);
+
+        queue_receive(&display_q, &ref);
+        sink += sample_pool_get(ref)->timestamp;
+        sample_pool_release(ref);
+        queue_receive(&alert_q, &ref);
+        sink += sample_pool_get(ref)->alert.mode;
+        sample_pool_release(ref);
+    }
+    return now_s() - start;
+}
+
+// Melhor de várias rodadas, com as contagens de uma rodada
+static bench_result_t measure(double (*run)(void)) {
+    bench_result_t result = { .ns_per_sample = 1e30 };
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        bytes_copied = 0;
+        critical_sections = 0;
+        double elapsed = run();
+        if (elapsed * 1e9 / BENCH_SAMPLES < result.ns_per_sample) {
+            result.ns_per_sample = elapsed * 1e9 / BENCH_SAMPLES;
+        }
+        result.bytes_per_sample = (double)bytes_copied / BENCH_SAMPLES;
+        result.critical_per_sample = (double)critical_sections / BENCH_SAMPLES;
+    }
+    return result;
+}
+
+int main(void) {
+    bench_result_t copy = measure(run_copy);
+    bench_result_t pool = measure(run_pool);
+
+    printf("{\"bench\":\"sample_pipeline\",\"channels\":%d,\"sample_bytes\":%zu,"
+           "\"copy_ns_per_sample\":%.1f,\"pool_ns_per_sample\":%.1f,"
+           "\"copy_bytes_per_sample\":%.0f,\"pool_bytes_per_sample\":%.0f,"
+           "\"copy_critical_per_sample\":%.0f,\"pool_critical_per_sample\":%.0f}\n",
+           SENSOR_MAX_CHANNELS, sizeof(sensor_data_t), copy.ns_per_sample, pool.ns_per_sample,
+           copy.bytes_per_sample, pool.bytes_per_sample, copy.critical_per_sample, pool.critical_per_sample);
+    return sink == 0xFFFFFFFFu;
+}
@@ -0,0 +1,182 @@
+// Benchmark no host: custo das primitivas gráficas do ssd1306, do quadro completo
+// do painel (dashboard_render) e dos bytes I2C gerados por ssd1306_send_data.
+//
+// Compilação (a partir da raiz do projeto):
+//   gcc -O2 -Itools/host -Ilib tools/bench_ssd1306.c lib/ssd1306.c lib/dashboard.c lib/sparkline.c lib/history.c -o bench_ssd1306
+//
+// Saída: uma linha JSON por caso. Os tempos são o melhor de BENCH_REPEATS rodadas;
+// as contagens de I2C são exatas e servem para acompanhar regressões entre commits.
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "ssd1306.h"
+#include "dashboard.h"
+
+#define BENCH_REPEATS 5
+#define I2C_BAUD_HZ 400000
+
+// Contadores do barramento simulado
+static uint32_t i2c_transactions;
+static uint32_t i2c_bytes;
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    (void)i2c;
+    (void)addr;
+    (void)src;
+    (void)nostop;
+    i2c_transactions++;
+    i2c_bytes += (uint32_t)len;
+    return (int)len;
+}
+
+static void i2c_reset_counters(void) {
+    i2c_transactions = 0;
+    i2c_bytes = 0;
+}
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static ssd1306_t display;
+static volatile uint32_t sink;
+
+typedef void (*bench_fn_t)(uint32_t n);
+
+static void bench_fill(uint32_t n) { ssd1306_fill(&display, n & 1); }
+static void bench_pixel(uint32_t n) { ssd1306_pixel(&display, n % WIDTH, (n >> 7) % HEIGHT, true); }
+static void bench_rect(uint32_t n) { ssd1306_rect(&display, 16, 64, 60, 8, true, false); (void)n; }
+static void bench_rect_fill(uint32_t n) { ssd1306_rect(&display, 17, 64, 58, 6, true, true); (void)n; }
+static void bench_line(uint32_t n) { ssd1306_line(&display, 0, n % HEIGHT, WIDTH - 1, HEIGHT - 1 - n % HEIGHT, true); }
+static void bench_hline(uint32_t n) { ssd1306_hline(&display, 0, WIDTH - 1, n % HEIGHT, true); }
+static void bench_vline(uint32_t n) { ssd1306_vline(&display, n % WIDTH, 0, HEIGHT - 1, true); }
+static void bench_draw_char(uint32_t n) { ssd1306_draw_char(&display, ' ' + n % 95, 8 * (n % 15), 8 * (n % 7)); }
+static void bench_draw_string(uint32_t n) { ssd1306_draw_string(&display, "STATUS: ATENCAO!", 0, 8 * (n % 7)); }
+
+// Amostras representativas para o painel, uma por modo
+static sensor_data_t samples[4];
+
+static void init_samples(void) {
+    static const float water[] = { 35.0f, 72.0f, 84.0f, 97.0f };
+    static const float rain[] = { 10.0f, 55.0f, 81.0f, 100.0f };
+    static const int32_t ttc[] = { -1, 4000, 754, 12 };
+
+    for (int i = 0; i < 4; i++) {
+        memset(&samples[i], 0, sizeof(samples[i]));
+        samples[i].channel_count = 2;
+        samples[i].value[0] = water[i];
+        samples[i].value[1] = rain[i];
+        samples[i].mode = (SystemMode)i;
+        samples[i].time_to_critical = ttc[i];
+        samples[i].pre_alert = (i == 1);
+    }
+}
+
+// Históricos cheios e gráficos sincronizados, como no regime permanente do display
+static history_t water_history, rain_history;
+static sparkline_t water_graph, rain_graph;
+
+static void init_history(void) {
+    history_init(&water_history, 1000);
+    history_init(&rain_history, 1000);
+    for (uint32_t t = 0; t <= 1000 * (HISTORY_LENGTH + 8); t += 100) {
+        history_add(&water_history, 50.0f + 45.0f * ((t / 7000) % 2 ? 1.0f : -1.0f) * (t % 7000) / 7000.0f, t);
+        history_add(&rain_history, (float)((t / 1000) % 100), t);
+    }
+    sparkline_init(&water_graph);
+    sparkline_init(&rain_graph);
+    sparkline_sync(&water_graph, &water_history);
+    sparkline_sync(&rain_graph, &rain_history);
+}
+
+// Uma coluna nova por gráfico a cada chamada, como na passagem de um intervalo do histórico
+static void bench_history(uint32_t n) {
+    history_add(&water_history, (float)(n % 100), 1000 * (HISTORY_LENGTH + 9 + n));
+    history_add(&rain_history, (float)(n % 100), 1000 * (HISTORY_LENGTH + 9 + n));
+    sparkline_sync(&water_graph, &water_history);
+    sparkline_sync(&rain_graph, &rain_history);
+    dashboard_draw_history(&display, &water_graph, &rain_graph);
+}
+
+static void bench_dashboard(uint32_t n) { dashboard_render(&display, &samples[n & 3], 0, 1); }
+static void bench_send_data(uint32_t n) { ssd1306_send_data(&display); (void)n; }
+
+static void bench_frame(uint32_t n) {
+    dashboard_render(&display, &samples[n & 3], 0, 1);
+    dashboard_draw_history(&display, &water_graph, &rain_graph);
+    ssd1306_send_data(&display);
+}
+
+// Executa o caso e devolve o melhor tempo por operação em ns
+static double run(bench_fn_t fn, uint32_t iterations) {
+    double best = 0.0;
+    for (int r = 0; r < BENCH_REPEATS; r++) {
+        ssd1306_fill(&display, false);
+        double start = now_s();
+        for (uint32_t n = 0; n < iterations; n++) {
+            fn(n);
+        }
+        double elapsed = (now_s() - start) / iterations;
+        if (r == 0 || elapsed < best) {
+            best = elapsed;
+        }
+        sink += display.ram_buffer[1 + (r % (display.bufsize - 1))];
+    }
+    return best * 1e9;
+}
+
+// Mede as transações e bytes de uma única chamada do caso
+static void count_i2c(bench_fn_t fn) {
+    i2c_reset_counters();
+    fn(0);
+}
+
+static void report(const char *name, bench_fn_t fn, uint32_t iterations) {
+    double ns = run(fn, iterations);
+    count_i2c(fn);
+
+    // Cada transação leva ainda o byte de endereço; cada byte ocupa 9 bits no barramento
+    uint32_t wire_bytes = i2c_bytes + i2c_transactions;
+    printf("{\"bench\":\"ssd1306\",\"case\":\"%s\",\"iterations\":%u,\"ns_per_op\":%.1f,"
+           "\"i2c_transactions\":%u,\"i2c_bytes\":%u,\"i2c_bus_us\":%.1f}\n",
+           name, iterations, ns, i2c_transactions, i2c_bytes,
+           wire_bytes * 9.0 * 1e6 / I2C_BAUD_HZ);
+}
+
+static void bench_config(uint32_t n) { ssd1306_config(&display); (void)n; }
+static void bench_invert(uint32_t n) { ssd1306_invert(&display, !display.inverted); (void)n; }
+static void bench_start_line(uint32_t n) { ssd1306_set_start_line(&display, n % HEIGHT); }
+static void bench_scroll(uint32_t n) { ssd1306_scroll_horizontal(&display, n & 1, 0, 1, SSD1306_SCROLL_5_FRAMES); }
+static void bench_orientation(uint32_t n) { ssd1306_set_orientation(&display, (ssd1306_orientation_t)(n & 3)); }
+
+int main(void) {
+    static uint8_t buffer[SSD1306_BUFFER_SIZE(WIDTH, HEIGHT)];
+
+    ssd1306_init_with_buffer(&display, WIDTH, HEIGHT, false, 0x3C, NULL, buffer);
+    init_samples();
+    init_history();
+
+    report("fill", bench_fill, 20000);
+    report("pixel", bench_pixel, 5000000);
+    report("rect", bench_rect, 500000);
+    report("rect_fill", bench_rect_fill, 200000);
+    report("line", bench_line, 200000);
+    report("hline", bench_hline, 500000);
+    report("vline", bench_vline, 500000);
+    report("draw_char", bench_draw_char, 1000000);
+    report("draw_string", bench_draw_string, 100000);
+    report("dashboard_render", bench_dashboard, 20000);
+    report("dashboard_history", bench_history, 1000000);
+    report("send_data", bench_send_data, 1000000);
+    report("dashboard_frame", bench_frame, 20000);
+    report("config", bench_config, 1000000);
+    report("invert", bench_invert, 1000000);
+    report("start_line", bench_start_line, 1000000);
+    report("scroll_horizontal", bench_scroll, 1000000);
+    report("orientation", bench_orientation, 1000000);
+
+    return sink == 0xFFFFFFFFu;
+}
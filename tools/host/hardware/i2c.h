@@ -0,0 +1,14 @@
+// Substituto do hardware/i2c.h para o host: a ferramenta que inclui este cabeçalho
+// fornece i2c_write_blocking (normalmente contando transações e bytes)
+#ifndef HOST_HARDWARE_I2C_H
+#define HOST_HARDWARE_I2C_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct i2c_inst i2c_inst_t;
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+
+#endif
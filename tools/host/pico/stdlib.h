@@ -0,0 +1,10 @@
+// Substituto mínimo do pico/stdlib.h para compilar módulos de lib/ no host
+#ifndef HOST_PICO_STDLIB_H
+#define HOST_PICO_STDLIB_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#endif
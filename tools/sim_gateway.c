@@ -0,0 +1,429 @@
+// Simulador no host: N estações rodando a lógica da estação (canais, filtros de Hampel,
+// tendência, classificação e regras de alerta de lib/) em um único processo, cada uma
+// com sua própria série sintética de nível e chuva. Cada estação decide os eventos de
+// alerta como a vProcessingTask e envia quadros binários de telemetria
+// (lib/telemetry_frame.h). Um agregador local decodifica o fluxo e mantém o estado
+// por estação e o alerta da bacia.
+//
+// Também serve de porta de regressão: a latência de detecção (do instante em que o
+// nível sem ruído cruza o limiar de alerta até o canal de nível entrar em ALERT) vai
+// para um histograma de lib/latency_hist.c, e o programa termina com código 1 se o
+// p99 passar de DETECT_P99_BUDGET_MS em algum N.
+//
+// Compilação (a partir da raiz do projeto):
+//   gcc -O2 -Ilib tools/sim_gateway.c lib/sensor_channel.c lib/sensor_filter.c lib/prediction.c lib/rule_engine.c lib/telemetry_frame.c lib/warm_state.c lib/latency_hist.c -lm -o sim_gateway
+//
+// Uso: ./sim_gateway [duracao_s] [N ...]   (padrão: 1800 s e N = 1 10 100 1000)
+// Argumento que não seja inteiro positivo encerra com a mensagem de uso e código 2.
+//
+// Saída: uma linha JSON por N com a vazão de amostras e de quadros, o custo por amostra
+// na estação e por quadro no agregador, os bytes de telemetria e a memória por estação.
+
+#include <errno.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+#include "sensor_channel.h"
+#include "sensor_filter.h"
+#include "rule_engine.h"
+#include "telemetry_frame.h"
+#include "latency_hist.h"
+
+// Parâmetros da estação (os mesmos de EstacaoDeMonitoramento.c)
+#define SENSOR_PERIOD_MS 100
+#define TELEMETRY_PERIOD_MS 1000
+#define FILTER_WINDOW 7
+#define FILTER_HAMPEL_K 3.0f
+#define FILTER_MIN_DEVIATION 2.0f
+#define FILTER_CONFIRM_DELTA 5.0f
+#define WATER_LEVEL_ALERT 70.0f
+
+// Orçamento da latência de detecção (p99), da cheia cruzando o limiar ao ALERT; a
+// amostragem já está acelerada perto do limiar, então o p99 medido fica em dezenas de ms
+#ifndef DETECT_P99_BUDGET_MS
+#define DETECT_P99_BUDGET_MS 250
+#endif
+
+// Passo do relógio simulado: o menor período de amostragem (100 Hz em alerta)
+#define SIM_TICK_MS SENSOR_BURST_PERIOD_MS
+
+// A bacia entra em alerta quando ao menos 10% das estações (no mínimo 2, ou todas se
+// houver menos) estão em ALERT ou CRITICAL e sai abaixo de 5% (no mínimo 1). Cada
+// estado dura ao menos BASIN_HOLD_MS, para que estações oscilando no limiar não
+// alternem o alerta, mesmo em redes pequenas
+#define BASIN_ALERT_PERCENT 10
+#define BASIN_CLEAR_PERCENT 5
+#define BASIN_MIN_STATIONS 2
+#define BASIN_HOLD_MS 60000
+
+// Série sintética: cheia gaussiana com a chuva antecedendo o nível, ruído de ±1% e
+// picos isolados; a quantização imita o ADC lido em porcentagem inteira
+typedef struct {
+    float base;
+    float peak;
+    float peak_s;
+    float width_s;
+    uint32_t seed;
+} trace_t;
+
+// Estado da estação: o mesmo que o firmware mantém, mais a série de entrada
+typedef struct {
+    sensor_registry_t registry;
+    hampel_filter_t filters[2];
+    rule_set_t rules;
+    sensor_data_t data;
+    uint16_t id;
+    uint32_t next_ms;
+    uint32_t last_telemetry_ms;
+    uint32_t last_alert_ms;
+    uint8_t last_mode;
+    bool last_pre_alert;
+    uint16_t sequence;
+    trace_t water;
+    trace_t rain;
+    int64_t alert_cross_ms;        // Cruzamento do limiar de alerta sem ruído (-1 = nunca)
+    bool detected;
+} station_t;
+
+// Estado por estação no agregador
+typedef struct {
+    uint16_t last_sequence;
+    bool seen;
+    uint8_t mode;
+    uint8_t flags;
+    int16_t level;                 // Décimos de %
+    int32_t time_to_critical;
+    uint32_t last_timestamp_ms;
+    uint32_t frames;
+    uint32_t lost;                 // Lacunas na sequência
+} gateway_station_t;
+
+typedef struct {
+    gateway_station_t *stations;
+    uint32_t count;
+    uint32_t mode_count[CRITICAL_MODE + 1];
+    uint32_t pre_alert_count;
+    uint32_t raise_at;             // Estações em alerta para a bacia entrar em alerta
+    uint32_t clear_below;          // Abaixo disso a bacia sai do alerta
+    bool basin_alert;
+    uint32_t basin_changed_ms;     // Última troca do alerta da bacia
+    uint32_t basin_alerts;         // Entradas no alerta da bacia
+    int64_t first_basin_alert_ms;
+    uint64_t frames;
+    uint64_t bytes;
+    uint64_t rejected;
+} gateway_t;
+
+// Regra do local carregada em todas as estações simuladas (o firmware parte sem regras)
+static const char *const default_rule[] = { "nivel", ">", "60", "e", "nivel.taxa", ">", "2", "por", "30", "alerta" };
+
+static uint32_t sim_now_ms;
+static station_t *current_station;
+static latency_hist_t detect_latency;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint32_t lcg(uint32_t *state) {
+    *state = *state * 1664525u + 1013904223u;
+    return *state >> 8;
+}
+
+static float read_trace(void *ctx) {
+    trace_t *trace = ctx;
+    float t = sim_now_ms / 1000.0f - trace->peak_s;
+    float value = trace->base + trace->peak * expf(-(t * t) / (2.0f * trace->width_s * trace->width_s));
+
+    value += (lcg(&trace->seed) % 200) / 100.0f - 1.0f;
+    if (lcg(&trace->seed) % 500 == 0) {
+        value += 50.0f;
+    }
+    value = floorf(value);
+    return value < 0.0f ? 0.0f : value > 100.0f ? 100.0f : value;
+}
+
+// Política dos canais da estação em amostragem
+static void apply_rules(sensor_data_t *data, uint32_t now_ms) {
+    rule_set_evaluate(&current_station->rules, data, now_ms);
+}
+
+// Estações ao longo do rio: a cheia chega antes nas de montante; a amplitude varia
+// de modo que só parte da bacia passa do limiar de alerta
+static void station_init(station_t *station, uint32_t id, float duration_s) {
+    uint32_t seed = id * 2654435761u + 1;
+    float position = (id % 50) / 50.0f;
+    float peak_s = duration_s * (0.3f + 0.5f * position);
+
+    memset(station, 0, sizeof(*station));
+    station->id = (uint16_t)id;
+    sensor_registry_init(&station->registry);
+    sensor_channels_select(&station->registry);
+
+    station->water = (trace_t){ .base = 20.0f + lcg(&seed) % 20, .peak = 30.0f + lcg(&seed) % 50,
+                                .peak_s = peak_s, .width_s = duration_s / 8.0f, .seed = lcg(&seed) };
+    station->rain = (trace_t){ .base = 10.0f + lcg(&seed) % 20, .peak = 40.0f + lcg(&seed) % 50,
+                               .peak_s = peak_s - duration_s / 10.0f, .width_s = duration_s / 10.0f,
+                               .seed = lcg(&seed) };
+
+    // Subida da cheia gaussiana pelo limiar de alerta, quando ela chega até ele
+    trace_t *w = &station->water;
+    station->alert_cross_ms = -1;
+    if (w->base < WATER_LEVEL_ALERT && w->base + w->peak > WATER_LEVEL_ALERT) {
+        float cross_s = w->peak_s - w->width_s * sqrtf(2.0f * logf(w->peak / (WATER_LEVEL_ALERT - w->base)));
+        station->alert_cross_ms = cross_s > 0.0f ? (int64_t)(cross_s * 1000.0f) : -1;
+    }
+
+    int water = sensor_channel_register(&(sensor_channel_t){
+        .name = "nivel", .read = read_trace, .ctx = &station->water, .period_ms = SENSOR_PERIOD_MS,
+        .adaptive = true, .warning = 50.0f, .alert = WATER_LEVEL_ALERT, .critical = 85.0f, .worsening_rate = 2.0f, .predicts = true,
+        .confirm_delta = FILTER_CONFIRM_DELTA,
+    });
+    int rain = sensor_channel_register(&(sensor_channel_t){
+        .name = "chuva", .read = read_trace, .ctx = &station->rain, .period_ms = SENSOR_PERIOD_MS,
+        .adaptive = true, .warning = 60.0f, .alert = 80.0f, .critical = 90.0f, .worsening_rate = 3.0f,
+        .confirm_delta = FILTER_CONFIRM_DELTA,
+    });
+    for (int i = 0; i < 2; i++) {
+        hampel_filter_init(&station->filters[i], FILTER_WINDOW, FILTER_HAMPEL_K, FILTER_MIN_DEVIATION);
+    }
+    sensor_channel_add_filter(water, hampel_filter_apply, &station->filters[0]);
+    sensor_channel_add_filter(rain, hampel_filter_apply, &station->filters[1]);
+    rule_compile(&station->rules.rules[0], default_rule, sizeof(default_rule) / sizeof(default_rule[0]), NULL);
+    sensor_channels_set_policy(apply_rules);
+}
+
+// Uma volta das tarefas de sensor e de processamento; devolve o tamanho do quadro
+// escrito em buffer (0 quando não há telemetria nesta amostra)
+static size_t station_step(station_t *station, uint8_t *buffer) {
+    current_station = station;
+    sensor_channels_select(&station->registry);
+
+    uint32_t wait = sensor_channels_sample(&station->data, sim_now_ms);
+    station->next_ms = sim_now_ms + (wait > 0 ? wait : 1);
+
+    // Latência de detecção: primeira amostra com o canal de nível em ALERT após o cruzamento
+    const sensor_data_t *data = &station->data;
+    if (!station->detected && station->alert_cross_ms >= 0 && sim_now_ms >= station->alert_cross_ms &&
+        data->channel_mode[0] >= ALERT_MODE) {
+        latency_hist_record(&detect_latency, (uint32_t)(sim_now_ms - station->alert_cross_ms) * 1000u);
+        station->detected = true;
+    }
+
+    // Eventos de alerta: troca de modo, entrada em pré-alerta e repetição a cada 10 s
+    bool event = data->mode != station->last_mode || (data->pre_alert && !station->last_pre_alert) ||
+                 (data->mode != NORMAL_MODE && sim_now_ms - station->last_alert_ms >= 10000);
+    if (event) {
+        station->last_alert_ms = sim_now_ms;
+    }
+    station->last_mode = (uint8_t)data->mode;
+    station->last_pre_alert = data->pre_alert;
+
+    // Telemetria periódica e imediata nos eventos de alerta
+    if (!event && sim_now_ms - station->last_telemetry_ms < TELEMETRY_PERIOD_MS) {
+        return 0;
+    }
+    station->last_telemetry_ms = sim_now_ms;
+
+    telemetry_frame_t frame;
+    telemetry_frame_from_sample(&frame, data, station->id, station->sequence++);
+    return telemetry_frame_encode(&frame, buffer);
+}
+
+static void gateway_init(gateway_t *gateway, uint32_t count) {
+    memset(gateway, 0, sizeof(*gateway));
+    gateway->stations = calloc(count, sizeof(gateway_station_t));
+    gateway->count = count;
+    gateway->mode_count[NORMAL_MODE] = count;
+
+    uint32_t raise_at = (count * BASIN_ALERT_PERCENT + 99) / 100;
+    uint32_t clear_below = count * BASIN_CLEAR_PERCENT / 100;
+    raise_at = raise_at > BASIN_MIN_STATIONS ? raise_at : BASIN_MIN_STATIONS;
+    gateway->raise_at = raise_at < count ? raise_at : count;
+    gateway->clear_below = clear_below > 1 ? clear_below : 1;
+    gateway->first_basin_alert_ms = -1;
+}
+
+// Consome o fluxo de quadros; cada quadro atualiza a estação e os contadores da bacia em O(1)
+static void gateway_ingest(gateway_t *gateway, const uint8_t *stream, size_t length) {
+    telemetry_frame_t frame;
+    size_t offset = 0;
+
+    while (offset < length) {
+        size_t size = telemetry_frame_decode(stream + offset, length - offset, &frame);
+        if (size == 0 || frame.station >= gateway->count) {
+            // Ressincroniza no próximo byte de sync
+            gateway->rejected++;
+            offset++;
+            while (offset < length && stream[offset] != TELEMETRY_FRAME_SYNC) {
+                offset++;
+            }
+            continue;
+        }
+        offset += size;
+        gateway->frames++;
+        gateway->bytes += size;
+
+        gateway_station_t *station = &gateway->stations[frame.station];
+        if (station->seen && (uint16_t)(frame.sequence - station->last_sequence) != 1) {
+            station->lost += (uint16_t)(frame.sequence - station->last_sequence - 1);
+        }
+        gateway->mode_count[station->mode]--;
+        gateway->mode_count[frame.mode]++;
+        gateway->pre_alert_count += ((frame.flags & TELEMETRY_FLAG_PRE_ALERT) != 0) -
+                                    ((station->flags & TELEMETRY_FLAG_PRE_ALERT) != 0);
+        station->seen = true;
+        station->last_sequence = frame.sequence;
+        station->mode = frame.mode;
+        station->flags = frame.flags;
+        station->level = frame.channel_count > 0 ? frame.value[0] : 0;
+        station->time_to_critical = frame.time_to_critical;
+        station->last_timestamp_ms = frame.timestamp_ms;
+        station->frames++;
+    }
+
+    uint32_t alerting = gateway->mode_count[ALERT_MODE] + gateway->mode_count[CRITICAL_MODE];
+    bool basin_alert = gateway->basin_alert ? alerting >= gateway->clear_below : alerting >= gateway->raise_at;
+    bool held = gateway->basin_alerts > 0 && sim_now_ms - gateway->basin_changed_ms < BASIN_HOLD_MS;
+    if (basin_alert == gateway->basin_alert || held) {
+        return;
+    }
+    if (basin_alert) {
+        gateway->basin_alerts++;
+        if (gateway->first_basin_alert_ms < 0) {
+            gateway->first_basin_alert_ms = sim_now_ms;
+        }
+    }
+    gateway->basin_alert = basin_alert;
+    gateway->basin_changed_ms = sim_now_ms;
+}
+
+// Devolve false se o p99 da latência de detecção passou do orçamento ou se não houve
+// detecção alguma
+static bool run(uint32_t count, uint32_t duration_s) {
+    station_t *stations = calloc(count, sizeof(station_t));
+    uint8_t *stream = malloc((size_t)count * TELEMETRY_FRAME_MAX);
+    gateway_t gateway;
+    uint64_t samples = 0, lost = 0;
+    uint32_t peak_alerting = 0, peak_pre_alert = 0;
+    double station_s = 0.0, gateway_s = 0.0;
+
+    if (stations == NULL || stream == NULL) {
+        fprintf(stderr, "sem memoria para %u estacoes\n", count);
+        exit(1);
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        station_init(&stations[i], i, (float)duration_s);
+    }
+    gateway_init(&gateway, count);
+    latency_hist_reset(&detect_latency);
+
+    for (sim_now_ms = 0; sim_now_ms < duration_s * 1000u; sim_now_ms += SIM_TICK_MS) {
+        size_t length = 0;
+
+        double start = now_s();
+        for (uint32_t i = 0; i < count; i++) {
+            if ((int32_t)(sim_now_ms - stations[i].next_ms) >= 0) {
+                length += station_step(&stations[i], stream + length);
+                samples++;
+            }
+        }
+        double middle = now_s();
+        station_s += middle - start;
+        if (length > 0) {
+            gateway_ingest(&gateway, stream, length);
+            gateway_s += now_s() - middle;
+        }
+
+        uint32_t alerting = gateway.mode_count[ALERT_MODE] + gateway.mode_count[CRITICAL_MODE];
+        if (alerting > peak_alerting) {
+            peak_alerting = alerting;
+        }
+        if (gateway.pre_alert_count > peak_pre_alert) {
+            peak_pre_alert = gateway.pre_alert_count;
+        }
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        lost += gateway.stations[i].lost;
+    }
+
+    uint32_t p99_ms = latency_hist_percentile(&detect_latency, 99.0f) / 1000;
+    // Sem nenhuma detecção a porta não mediu nada e também falha
+    bool ok = detect_latency.total > 0 && p99_ms <= DETECT_P99_BUDGET_MS;
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    size_t station_bytes = sizeof(sensor_registry_t) + sizeof(stations[0].filters) + sizeof(rule_set_t) +
+                           sizeof(sensor_data_t);
+    printf("{\"bench\":\"gateway\",\"stations\":%u,\"sim_s\":%u,\"samples\":%llu,\"samples_per_s\":%.0f,"
+           "\"ns_per_sample\":%.0f,\"frames\":%llu,\"frames_per_s\":%.0f,\"ns_per_frame\":%.0f,"
+           "\"realtime_factor\":%.1f,\"tlm_bytes_per_station_s\":%.1f,\"station_bytes\":%zu,"
+           "\"gateway_bytes_per_station\":%zu,\"rejected\":%llu,\"lost\":%llu,\"peak_alerting\":%u,\"peak_pre_alert\":%u,"
+           "\"basin_alerts\":%u,\"first_basin_alert_s\":%.1f,\"detections\":%u,\"detect_p50_ms\":%u,"
+           "\"detect_p99_ms\":%u,\"detect_max_ms\":%u,\"detect_budget_ms\":%u,\"detect_ok\":%s,\"max_rss_kb\":%ld}\n",
+           count, duration_s, (unsigned long long)samples, samples / station_s, station_s * 1e9 / samples,
+           (unsigned long long)gateway.frames, gateway.frames / gateway_s, gateway_s * 1e9 / gateway.frames,
+           duration_s / (station_s + gateway_s), (double)gateway.bytes / count / duration_s, station_bytes,
+           sizeof(gateway_station_t), (unsigned long long)gateway.rejected, (unsigned long long)lost,
+           peak_alerting, peak_pre_alert, gateway.basin_alerts, gateway.first_basin_alert_ms / 1000.0,
+           detect_latency.total, latency_hist_percentile(&detect_latency, 50.0f) / 1000,
+           p99_ms, detect_latency.max_us / 1000, DETECT_P99_BUDGET_MS, ok ? "true" : "false", usage.ru_maxrss);
+
+    sensor_channels_select(NULL);
+    free(gateway.stations);
+    free(stream);
+    free(stations);
+    return ok;
+}
+
+// Inteiro positivo em decimal; devolve false para texto, sinal, zero ou estouro
+static bool parse_positive(const char *text, uint32_t *value) {
+    char *end;
+
+    if (*text < '0' || *text > '9') {
+        return false;
+    }
+    errno = 0;
+    unsigned long parsed = strtoul(text, &end, 10);
+    if (errno != 0 || *end != '\0' || parsed == 0 || parsed > UINT32_MAX) {
+        return false;
+    }
+    *value = (uint32_t)parsed;
+    return true;
+}
+
+static int usage_error(const char *program) {
+    fprintf(stderr, "uso: %s [duracao_s] [N ...]   (inteiros positivos)\n", program);
+    return 2;
+}
+
+int main(int argc, char **argv) {
+    static const uint32_t default_counts[] = { 1, 10, 100, 1000 };
+    uint32_t duration_s = 1800;
+    bool ok = true;
+
+    if (argc > 1 && !parse_positive(argv[1], &duration_s)) {
+        return usage_error(argv[0]);
+    }
+    if (argc > 2) {
+        uint32_t counts[argc - 2];
+        for (int i = 2; i < argc; i++) {
+            if (!parse_positive(argv[i], &counts[i - 2])) {
+                return usage_error(argv[0]);
+            }
+        }
+        for (int i = 0; i < argc - 2; i++) {
+            ok = run(counts[i], duration_s) && ok;
+        }
+    } else {
+        for (size_t i = 0; i < sizeof(default_counts) / sizeof(default_counts[0]); i++) {
+            ok = run(default_counts[i], duration_s) && ok;
+        }
+    }
+    return ok ? 0 : 1;
+}
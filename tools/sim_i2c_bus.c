@@ -0,0 +1,280 @@
+// Simulador no host: escalonamento do servidor do barramento I2C (lib/i2c_bus.c) em um
+// núcleo com prioridades fixas e preempção, com passo de 1 µs. Um sensor I2C de alta
+// prioridade é liberado a cada 10 ms enquanto o display envia quadros de 1 KB em blocos,
+// com período defasado para que a leitura caia em todos os pontos do quadro.
+//
+// Duas políticas para o servidor:
+//   teto:    prioridade fixa acima de todas as clientes (a versão anterior)
+//   herdada: prioridade do cliente mais prioritário à espera (a atual)
+//
+// As transferências esperam ativamente, como i2c_write_timeout_us: só avançam enquanto
+// o servidor tem a CPU. A espera da leitura é contada da liberação do sensor até o
+// início da transação, como o max_high_wait_us do firmware. O programa termina com
+// código 1 se, na política herdada, o p99 dessa espera passar de WAIT_BUDGET_US ou se o
+// display perder o prazo.
+//
+// Compilação (a partir da raiz do projeto):
+//   gcc -O2 -Ilib tools/sim_i2c_bus.c lib/latency_hist.c -o sim_i2c_bus
+//
+// Uso: ./sim_i2c_bus [duracao_s]   (padrão: 60 s)
+//
+// Saída: uma linha JSON por política com a espera da leitura (p50, p99 e máximo), a
+// resposta do sensor e do processamento, as liberações perdidas e o maior tempo de quadro.
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "latency_hist.h"
+
+// Barramento (os mesmos de lib/i2c_bus.h, a 400 kHz)
+#define CHUNK_BYTES 32                 // I2C_BUS_CHUNK_BYTES
+#define BYTE_US 22.5                   // 9 bits a 400 kHz
+#define FRAME_BYTES 1025               // Byte de controle + 1 KB do quadro do SSD1306
+
+// Tarefas (prioridades na ordem derivada de EstacaoDeMonitoramento.c)
+#define PRIO_DISPLAY 1
+#define PRIO_ACTUATORS 2
+#define PRIO_PROCESSING 3
+#define PRIO_SENSOR 4
+#define PRIO_CEILING 5                 // Servidor na política de teto
+#define SENSOR_PERIOD_US 10000
+#define SENSOR_DEADLINE_US 10000
+#define SENSOR_CPU_US 50               // Antes da leitura
+#define SENSOR_READ_BYTES 10           // Endereço + registrador, endereço + 6 bytes
+#define PROCESSING_PERIOD_US 10000
+#define PROCESSING_OFFSET_US 300       // Amostra chega depois da leitura
+#define PROCESSING_CPU_US 400
+#define PROCESSING_DEADLINE_US 20000
+#define ACTUATORS_PERIOD_US 100000
+#define ACTUATORS_CPU_US 600
+#define DISPLAY_PERIOD_US 200700       // Defasado do sensor
+#define DISPLAY_CPU_US 2000            // Desenho do painel
+#define DISPLAY_DEADLINE_US 200000
+
+#ifndef WAIT_BUDGET_US
+#define WAIT_BUDGET_US 1000
+#endif
+
+typedef enum { POLICY_CEILING, POLICY_INHERIT } policy_t;
+
+typedef enum { TASK_IDLE, TASK_READY, TASK_WAITING_BUS } task_state_t;
+
+// Cliente: CPU antes do barramento, transação (0 = nenhuma), CPU depois
+typedef struct {
+    const char *name;
+    int priority;
+    uint32_t period_us, offset_us, deadline_us;
+    uint32_t cpu_before_us, bus_bytes, cpu_after_us;
+    bool high;                         // Fila de alta prioridade
+    task_state_t state;
+    uint32_t released_us, remaining_us, next_release_us;
+    bool after_bus;
+    uint32_t skipped, max_response_us;
+    latency_hist_t response;
+} sim_task_t;
+
+// Servidor: transação de alta em andamento, escrita em blocos em andamento
+typedef struct {
+    sim_task_t *high_queue[8];
+    int high_count;
+    sim_task_t *low_queue[8];
+    int low_count;
+    sim_task_t *high, *low;
+    double high_left_us, chunk_left_us;
+    uint32_t low_bytes_left;
+    bool chunk_open;
+} sim_server_t;
+
+static latency_hist_t wait_hist;
+
+static int server_priority(policy_t policy, const sim_server_t *server) {
+    if (policy == POLICY_CEILING) {
+        return PRIO_CEILING;
+    }
+    int priority = PRIO_DISPLAY;       // Base: a menor entre as clientes
+    for (int i = 0; i < server->high_count; i++) {
+        priority = server->high_queue[i]->priority > priority ? server->high_queue[i]->priority : priority;
+    }
+    for (int i = 0; i < server->low_count; i++) {
+        priority = server->low_queue[i]->priority > priority ? server->low_queue[i]->priority : priority;
+    }
+    if (server->high != NULL && server->high->priority > priority) {
+        priority = server->high->priority;
+    }
+    if (server->low != NULL && server->low->priority > priority) {
+        priority = server->low->priority;
+    }
+    return priority;
+}
+
+static bool server_ready(const sim_server_t *server) {
+    return server->high != NULL || server->low != NULL || server->high_count > 0 || server->low_count > 0;
+}
+
+static sim_task_t *dequeue(sim_task_t **queue, int *count) {
+    sim_task_t *task = queue[0];
+    for (int i = 1; i < *count; i++) {
+        queue[i - 1] = queue[i];
+    }
+    (*count)--;
+    return task;
+}
+
+static void finish_job(sim_task_t *task, uint32_t now_us) {
+    uint32_t response = now_us - task->released_us;
+    latency_hist_record(&task->response, response);
+    if (response > task->max_response_us) {
+        task->max_response_us = response;
+    }
+    task->state = TASK_IDLE;
+}
+
+// Conclusão da transação: o cliente volta a ficar pronto para a CPU restante
+static void bus_done(sim_task_t *task, uint32_t now_us) {
+    task->after_bus = true;
+    task->remaining_us = task->cpu_after_us;
+    if (task->remaining_us == 0) {
+        finish_job(task, now_us);
+    } else {
+        task->state = TASK_READY;
+    }
+}
+
+// Um microssegundo de CPU do servidor, na ordem de vI2CBusTask e write_chunked
+static void server_step(sim_server_t *server, uint32_t now_us) {
+    if (server->high == NULL && !server->chunk_open && server->high_count > 0) {
+        server->high = dequeue(server->high_queue, &server->high_count);
+        server->high_left_us = server->high->bus_bytes * BYTE_US;
+        latency_hist_record(&wait_hist, now_us - server->high->released_us);
+    }
+    if (server->high != NULL) {
+        server->high_left_us -= 1.0;
+        if (server->high_left_us <= 0.0) {
+            bus_done(server->high, now_us + 1);
+            server->high = NULL;
+        }
+        return;
+    }
+    if (server->low == NULL) {
+        if (server->low_count == 0) {
+            return;
+        }
+        server->low = dequeue(server->low_queue, &server->low_count);
+        server->low_bytes_left = server->low->bus_bytes - 1;
+    }
+    if (!server->chunk_open) {
+        uint32_t n = server->low_bytes_left > CHUNK_BYTES ? CHUNK_BYTES : server->low_bytes_left;
+        server->chunk_left_us = (n + 2) * BYTE_US;
+        server->low_bytes_left -= n;
+        server->chunk_open = true;
+    }
+    server->chunk_left_us -= 1.0;
+    if (server->chunk_left_us <= 0.0) {
+        server->chunk_open = false;
+        if (server->low_bytes_left == 0) {
+            bus_done(server->low, now_us + 1);
+            server->low = NULL;
+        }
+    }
+}
+
+static void task_step(sim_task_t *task, sim_server_t *server, uint32_t now_us) {
+    if (--task->remaining_us > 0) {
+        return;
+    }
+    if (!task->after_bus && task->bus_bytes > 0) {
+        task->state = TASK_WAITING_BUS;
+        if (task->high) {
+            server->high_queue[server->high_count++] = task;
+        } else {
+            server->low_queue[server->low_count++] = task;
+        }
+        return;
+    }
+    finish_job(task, now_us + 1);
+}
+
+static bool run(policy_t policy, uint32_t duration_s) {
+    sim_task_t tasks[] = {
+        { .name = "sensor", .priority = PRIO_SENSOR, .period_us = SENSOR_PERIOD_US,
+          .deadline_us = SENSOR_DEADLINE_US, .cpu_before_us = SENSOR_CPU_US, .bus_bytes = SENSOR_READ_BYTES,
+          .cpu_after_us = 20, .high = true },
+        { .name = "processamento", .priority = PRIO_PROCESSING, .period_us = PROCESSING_PERIOD_US,
+          .offset_us = PROCESSING_OFFSET_US, .deadline_us = PROCESSING_DEADLINE_US, .cpu_before_us = PROCESSING_CPU_US },
+        { .name = "atuadores", .priority = PRIO_ACTUATORS, .period_us = ACTUATORS_PERIOD_US, .offset_us = 500,
+          .deadline_us = ACTUATORS_PERIOD_US, .cpu_before_us = ACTUATORS_CPU_US },
+        { .name = "display", .priority = PRIO_DISPLAY, .period_us = DISPLAY_PERIOD_US, .offset_us = 1000,
+          .deadline_us = DISPLAY_DEADLINE_US, .cpu_before_us = DISPLAY_CPU_US, .bus_bytes = FRAME_BYTES },
+    };
+    const size_t count = sizeof(tasks) / sizeof(tasks[0]);
+    sim_server_t server = { 0 };
+
+    latency_hist_reset(&wait_hist);
+    for (size_t i = 0; i < count; i++) {
+        latency_hist_reset(&tasks[i].response);
+        tasks[i].next_release_us = tasks[i].offset_us;
+    }
+
+    for (uint32_t now = 0; now < duration_s * 1000000u; now++) {
+        for (size_t i = 0; i < count; i++) {
+            sim_task_t *task = &tasks[i];
+            if (now != task->next_release_us) {
+                continue;
+            }
+            task->next_release_us += task->period_us;
+            if (task->state != TASK_IDLE) {
+                task->skipped++;
+                continue;
+            }
+            task->state = TASK_READY;
+            task->released_us = now;
+            task->remaining_us = task->cpu_before_us;
+            task->after_bus = false;
+        }
+
+        // Maior prioridade pronta; no empate o servidor vence (o cliente está bloqueado)
+        sim_task_t *running = NULL;
+        for (size_t i = 0; i < count; i++) {
+            if (tasks[i].state == TASK_READY && (running == NULL || tasks[i].priority > running->priority)) {
+                running = &tasks[i];
+            }
+        }
+        if (server_ready(&server) && (running == NULL || server_priority(policy, &server) >= running->priority)) {
+            server_step(&server, now);
+        } else if (running != NULL) {
+            task_step(running, &server, now);
+        }
+    }
+
+    sim_task_t *sensor = &tasks[0], *processing = &tasks[1], *display = &tasks[3];
+    uint32_t p99 = latency_hist_percentile(&wait_hist, 99.0f);
+    bool ok = wait_hist.total > 0 && p99 <= WAIT_BUDGET_US && display->max_response_us <= DISPLAY_DEADLINE_US;
+    printf("{\"bench\":\"i2c_bus\",\"policy\":\"%s\",\"sim_s\":%u,\"reads\":%u,\"wait_p50_us\":%u,"
+           "\"wait_p99_us\":%u,\"wait_max_us\":%u,\"sensor_response_max_us\":%u,\"sensor_skipped\":%u,"
+           "\"processing_response_max_us\":%u,\"frame_max_us\":%u,\"budget_us\":%u,\"ok\":%s}\n",
+           policy == POLICY_CEILING ? "teto" : "herdada", duration_s, wait_hist.total,
+           latency_hist_percentile(&wait_hist, 50.0f), p99, wait_hist.max_us, sensor->max_response_us,
+           sensor->skipped, processing->max_response_us, display->max_response_us, WAIT_BUDGET_US, ok ? "true" : "false");
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    uint32_t duration_s = 60;
+
+    if (argc > 1) {
+        char *end;
+        errno = 0;
+        unsigned long parsed = strtoul(argv[1], &end, 10);
+        if (argv[1][0] < '0' || argv[1][0] > '9' || errno != 0 || *end != '\0' || parsed == 0 || parsed > 3600) {
+            fprintf(stderr, "uso: %s [duracao_s]   (1 a 3600)\n", argv[0]);
+            return 2;
+        }
+        duration_s = (uint32_t)parsed;
+    }
+
+    // A política de teto é a referência; só a herdada decide o código de saída
+    run(POLICY_CEILING, duration_s);
+    return run(POLICY_INHERIT, duration_s) ? 0 : 1;
+}
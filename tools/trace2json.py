@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+"""Converte o dump do gravador de eventos (comando "trace dump") em uma linha do
+tempo JSON no formato Chrome Trace Event, aberta em chrome://tracing ou no Perfetto.
+
+Uso:
+    python3 tools/trace2json.py captura.txt > trace.json
+
+A entrada pode conter outras linhas (telemetria, etc.); apenas as linhas TRC; são lidas.
+"""
+
+import json
+import struct
+import sys
+
+EVT_TASK_SWITCH_IN = 1
+EVT_QUEUE_SEND = 2
+EVT_QUEUE_SEND_FAILED = 3
+EVT_QUEUE_RECEIVE = 4
+EVT_QUEUE_BLOCK_RECEIVE = 5
+EVT_QUEUE_BLOCK_SEND = 6
+
+QUEUE_EVENT_NAMES = {
+    EVT_QUEUE_SEND: "envio",
+    EVT_QUEUE_SEND_FAILED: "envio falhou",
+    EVT_QUEUE_RECEIVE: "recebimento",
+    EVT_QUEUE_BLOCK_RECEIVE: "bloqueio no recebimento",
+    EVT_QUEUE_BLOCK_SEND: "bloqueio no envio",
+}
+
+EVENT_FORMAT = "<IBBH"
+EVENT_SIZE = struct.calcsize(EVENT_FORMAT)
+
+
+def parse_dump(lines):
+    tasks, queues, events = {}, {}, []
+    for line in lines:
+        line = line.strip()
+        if not line.startswith("TRC;"):
+            continue
+        fields = line.split(";")
+        kind = fields[1]
+        if kind == "tarefa":
+            tasks[int(fields[2])] = fields[3]
+        elif kind == "fila":
+            queues[int(fields[2])] = fields[3]
+        elif kind == "e":
+            raw = bytes.fromhex(fields[2])
+            for offset in range(0, len(raw) - EVENT_SIZE + 1, EVENT_SIZE):
+                events.append(struct.unpack_from(EVENT_FORMAT, raw, offset))
+    return tasks, queues, events
+
+
+def unwrap_timestamps(events):
+    """O carimbo de 32 bits dá a volta a cada ~71 min; converte para tempo contínuo."""
+    result, offset, previous = [], 0, None
+    for timestamp, event, ident, arg in events:
+        if previous is not None and timestamp < previous and previous - timestamp > 0x80000000:
+            offset += 1 << 32
+        previous = timestamp
+        result.append((timestamp + offset, event, ident, arg))
+    return result
+
+
+def to_chrome_trace(tasks, queues, events):
+    trace = []
+    task_name = lambda n: tasks.get(n, "tarefa %d" % n)
+    queue_name = lambda n: queues.get(n, "fila %d" % n)
+
+    for number, name in tasks.items():
+        trace.append({"ph": "M", "name": "thread_name", "pid": 0, "tid": number, "args": {"name": name}})
+
+    if not events:
+        return {"traceEvents": trace, "displayTimeUnit": "ms"}
+
+    start = events[0][0]
+    running, running_since = None, None
+    for timestamp, event, ident, arg in events:
+        ts = timestamp - start
+        if event == EVT_TASK_SWITCH_IN:
+            # Cada intervalo em execução vira um evento completo na linha da tarefa
+            if running is not None:
+                trace.append({"ph": "X", "name": task_name(running), "pid": 0, "tid": running,
+                              "ts": running_since, "dur": max(ts - running_since, 0)})
+            running, running_since = ident, ts
+        elif event in QUEUE_EVENT_NAMES:
+            tid = arg if event in (EVT_QUEUE_BLOCK_RECEIVE, EVT_QUEUE_BLOCK_SEND) else running
+            args = {"fila": queue_name(ident)}
+            if event not in (EVT_QUEUE_BLOCK_RECEIVE, EVT_QUEUE_BLOCK_SEND):
+                args["mensagens"] = arg
+                # Contador de ocupação por fila
+                trace.append({"ph": "C", "name": "ocupacao " + queue_name(ident), "pid": 0,
+                              "ts": ts, "args": {"mensagens": arg}})
+            trace.append({"ph": "i", "s": "t", "name": "%s: %s" % (queue_name(ident), QUEUE_EVENT_NAMES[event]),
+                          "pid": 0, "tid": tid if tid is not None else 0, "ts": ts, "args": args})
+
+    if running is not None:
+        trace.append({"ph": "X", "name": task_name(running), "pid": 0, "tid": running,
+                      "ts": running_since, "dur": 0})
+    return {"traceEvents": trace, "displayTimeUnit": "ms"}
+
+
+def main():
+    if len(sys.argv) > 1:
+        with open(sys.argv[1], encoding="utf-8", errors="replace") as capture:
+            lines = capture.readlines()
+    else:
+        lines = sys.stdin.readlines()
+
+    tasks, queues, events = parse_dump(lines)
+    json.dump(to_chrome_trace(tasks, queues, unwrap_timestamps(events)), sys.stdout)
+    sys.stdout.write("\n")
+
+
+if __name__ == "__main__":
+    main()